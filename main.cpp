@@ -7,454 +7,3788 @@
 #include <limits.h>
 #include <stack>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <type_traits>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CITITOR_MMAP 1
+#endif
+
+#ifdef GRAF_INSTRUMENTARE
+
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/resource.h>
+
+#endif
+#endif
 
 using namespace std;
 
-class Graf {
-    int nrNoduri; // numarul de noduri ale grafului
-    vector<vector<int>> matriceAdiacenta; // matrice de adiacenta( un vector de vectori; primul element din fiecare vector este -1 )
-    bool esteOrientat; // esteOrientat = true -> graf orientat esle -> graf neorientat
+/*
+ * Instrumentare (activata la compilare cu -DGRAF_INSTRUMENTARE; altfel macro-urile de mai jos nu genereaza cod)
+ * Se masoara timpul si memoria rezidenta maxima pentru fiecare faza si se numara operatiile de baza ale algoritmilor
+ * La terminarea programului rezultatele sunt scrise in format JSON in fisierul dat de variabila de mediu
+ * GRAF_INSTRUMENTARE_FISIER sau, daca aceasta lipseste, in stderr
+ *   INSTR_FAZA("nume")        - masoara faza de la acest punct pana la sfarsitul blocului
+ *   INSTR_ETAPE("nume")       - masoara o succesiune de etape (citire, constructie, algoritm, afisare)...
+ *   INSTR_ETAPA("etapa")      - ...incheind etapa curenta si incepand una noua
+ *   INSTR_CONTOR(CONTOR, val) - aduna val la unul dintre contoarele de mai jos
+ */
+#ifdef GRAF_INSTRUMENTARE
+
+enum ContorInstrumentare {
+    NODURI_VIZITATE, MUCHII_SCANATE, HEAP_PUSH, HEAP_POP, NR_CONTOARE
+};
+
+class Instrumentare {
+    struct Faza {
+        long long apeluri = 0;
+        double secunde = 0;
+        long long rssMaximKb = 0;
+    };
+
+    mutex blocare;
+    map<string, Faza> faze;
 
 public:
-    Graf(int nrNoduri, const vector<vector<int>> &matriceAdiacenta, bool esteOrientat);
+    atomic<long long> contoare[NR_CONTOARE];
 
-    Graf(int nrNoduri, bool esteOrientat);
+    Instrumentare() {
+        for (auto &it: contoare) {
+            it = 0;
+        }
+    }
 
-    Graf(const Graf &graf);
+    ~Instrumentare() {
+        const char *numeFisier = getenv("GRAF_INSTRUMENTARE_FISIER");
+        FILE *fisier = numeFisier != nullptr ? fopen(numeFisier, "w") : nullptr;
+        if (fisier == nullptr) {
+            fisier = stderr;
+        }
+        const char *numeContoare[NR_CONTOARE] = {"noduri_vizitate", "muchii_scanate", "heap_push", "heap_pop"};
+
+        fprintf(fisier, "{\n  \"faze\": {");
+        bool primul = true;
+        for (auto &it: faze) {
+            fprintf(fisier, "%s\n    \"%s\": {\"apeluri\": %lld, \"secunde\": %.9f, \"rss_maxim_kb\": %lld}",
+                    primul ? "" : ",", it.first.c_str(), it.second.apeluri, it.second.secunde, it.second.rssMaximKb);
+            primul = false;
+        }
+        fprintf(fisier, "\n  },\n  \"contoare\": {");
+        for (int i = 0; i < NR_CONTOARE; i++) {
+            fprintf(fisier, "%s\n    \"%s\": %lld", i == 0 ? "" : ",", numeContoare[i], contoare[i].load());
+        }
+        fprintf(fisier, "\n  },\n  \"rss_maxim_kb\": %lld\n}\n", rssMaximKb());
+        if (fisier != stderr) {
+            fclose(fisier);
+        }
+    }
 
-    Graf() {};
+    static Instrumentare &instanta() {
+        static Instrumentare instrumentare;
+        return instrumentare;
+    }
 
-    void citireGraf(istream &in, int nrMuchii);
+    // memoria rezidenta maxima a procesului de la pornire, in KB
+    static long long rssMaximKb() {
+#if defined(__unix__) || defined(__APPLE__)
+        struct rusage utilizare;
+        getrusage(RUSAGE_SELF, &utilizare);
+#ifdef __APPLE__
+        return utilizare.ru_maxrss / 1024;
+#else
+        return utilizare.ru_maxrss;
+#endif
+#else
+        return 0;
+#endif
+    }
 
-    void adaugareMuchie(int startNode, int endNode);
+    void inregistrareFaza(const string &nume, double secunde) {
+        long long rss = rssMaximKb();
+        lock_guard<mutex> garda(blocare);
+        Faza &faza = faze[nume];
+        faza.apeluri++;
+        faza.secunde += secunde;
+        faza.rssMaximKb = max(faza.rssMaximKb, rss);
+    }
+};
 
-    void eliminareMuchie(int startNode, int endNode);
+class CronometruFaza {
+    string nume;
+    chrono::steady_clock::time_point start;
 
-    vector<int> distantaMinimaBFS(ostream &out, int start);
+public:
+    explicit CronometruFaza(string nume) : nume(move(nume)), start(chrono::steady_clock::now()) {}
 
-    int BFS_amici2(int start, vector<vector<int>> &matriceAdiacenta);
+    // incheie faza curenta si incepe una noua cu acelasi prefix
+    void etapa(const char *numeEtapa) {
+        oprire();
+        nume = nume.substr(0, nume.find('.')) + "." + numeEtapa;
+        start = chrono::steady_clock::now();
+    }
 
-    void bfs_marmelada(int start, vector<vector<pair<int, int>>> &matriceAdiacenta, vector<int> &vizitate,
-                       vector<int> &muchii);
+    void oprire() {
+        if (!nume.empty() && nume.back() != '.') {
+            Instrumentare::instanta().inregistrareFaza(
+                    nume, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+    }
 
-    int componenteConexe();
+    ~CronometruFaza() {
+        oprire();
+    }
+};
 
-    int componenteConexeRecursiv(vector<int> &vizitate, int startPos = 1);
+#define INSTR_CONCATENARE_(a, b) a##b
+#define INSTR_CONCATENARE(a, b) INSTR_CONCATENARE_(a, b)
+#define INSTR_FAZA(nume) CronometruFaza INSTR_CONCATENARE(cronometruFaza, __LINE__)(nume)
+#define INSTR_ETAPE(nume) CronometruFaza cronometruEtape(string(nume) + ".")
+#define INSTR_ETAPA(nume) cronometruEtape.etapa(nume)
+#define INSTR_CONTOR(contor, valoare) \
+    Instrumentare::instanta().contoare[contor].fetch_add((valoare), memory_order_relaxed)
 
-    vector<vector<int>> muchiiCritice_neeficient();
+#else
 
-    vector<vector<int>> DFS_muchiiCritice();
+#define INSTR_FAZA(nume)
+#define INSTR_ETAPE(nume)
+#define INSTR_ETAPA(nume)
+#define INSTR_CONTOR(contor, valoare)
 
-    vector<int> DFS_sortareTopologica(ostream &out);
+#endif
 
-    int disjoint(int cod, int x, int y, vector<int> &parinte, vector<int> &rang);
+/*
+ * Cititor rapid de numere intregi folosit de toate functiile care citesc din fisiere
+ * Fisierul este mapat in memorie (mmap) sau, daca nu se poate, citit integral intr-un buffer, iar numerele
+ * sunt parsate direct din memorie, fara formatarea facuta de ifstream
+ * Se foloseste la fel ca un ifstream: f >> a >> b >> c;
+ */
+class CititorRapid {
+    const char *date = nullptr; // continutul fisierului
+    size_t lungime = 0; // numarul de octeti din fisier
+    size_t pozitie = 0; // pozitia curenta in fisier
+    bool esteMapat = false;
+    bool deschis = false;
+    bool esuat = false; // true dupa prima citire care nu a gasit ce cauta (ca failbit la ifstream, nu se mai sterge)
+    vector<char> buffer; // folosit cand fisierul nu poate fi mapat
 
-    vector<int> dijkstra(vector<vector<pair<int, int>>> &matriceAdiacentaCosturi, int nodStart);
+public:
+    explicit CititorRapid(const char *numeFisier, bool accesSecvential = true);
 
-    vector<int> bellman_ford(vector<vector<pair<int, int>>> &matriceAdiacentaCosturi, int nodStart);
+    CititorRapid(const CititorRapid &) = delete;
 
-    void DFS_darb(int nod, vector<int> &vizitate, int &adancime, int &adancimeMax, int &nodAdancimeMax);
+    CititorRapid &operator=(const CititorRapid &) = delete;
 
-    vector<int> Euler(vector<vector<pair<int, int>>> matriceAdiacentaNrMuchii, int nrMuchii);
+    ~CititorRapid();
 
-    vector<vector<int>> APM(vector<vector<int>> muchii);
+    bool esteDeschis() const {
+        return deschis;
+    }
 
-    int hamilton(vector<vector<pair<int, int>>> matriceAdiacentaCosturi);
+    // false daca vreo citire a ajuns la sfarsitul fisierului sau a gasit un '-' fara cifre (valoarea citita este 0),
+    // astfel incat un fisier trunchiat poate fi detectat dupa citire
+    bool esteValid() const {
+        return deschis && !esuat;
+    }
 
-    void setMatriceAdiacenta(vector<vector<int>> matriceAdiacenta2) {
-        this->matriceAdiacenta = matriceAdiacenta2;
+    size_t octetiCititi() const {
+        return pozitie;
     }
 
-    void dfs_pamant(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
-                    vector<int> &result);
+    // acces direct la continutul fisierului, folosit pentru fisierele binare
+    const char *dateBrute() const {
+        return date;
+    }
 
-    friend istream &operator>>(istream &in, Graf &graf) {
-        cout << "\nEste graf orientat? (1 pentru DA, 0 pentru NU): ";
-        in >> graf.esteOrientat;
-        cout << "\nNumarul de noduri: ";
-        in >> graf.nrNoduri;
-        cout << "\nNumarul de muchii: ";
-        int nrMuchii;
-        in >> nrMuchii;
-        for (int i = 1; i <= nrMuchii; i++) {
-            cout << "Muchia numarul " << i << ": ";
-            int startNode, endNode;
-            in >> startNode >> endNode;
-            graf.adaugareMuchie(startNode, endNode);
+    size_t dimensiune() const {
+        return lungime;
+    }
+
+    // sare peste separatori si verifica daca a mai ramas vreun numar de citit
+    bool maiExistaNumere() {
+        while (pozitie < lungime && (date[pozitie] < '0' || date[pozitie] > '9') && date[pozitie] != '-') {
+            pozitie++;
         }
-        return in;
+        return pozitie < lungime;
     }
 
-    friend ostream &operator<<(ostream &out, Graf &graf) {
-        if (graf.esteOrientat) {
-            out << "Este graf orientat? DA";
-        } else {
-            out << "Este graf orientat? NU";
+    CititorRapid &operator>>(int &x) {
+        long long y;
+        *this >> y;
+        x = (int) y;
+        return *this;
+    }
+
+    CititorRapid &operator>>(long long &x) {
+        maiExistaNumere(); // sarim peste tot ce nu este cifra sau semn
+
+        bool negativ = false;
+        if (pozitie < lungime && date[pozitie] == '-') {
+            negativ = true;
+            pozitie++;
         }
-        out << "\nNumar noduri: " << graf.nrNoduri;
-        out << "\nMuchii:\n";
-        for (int i = 1; i <= graf.nrNoduri; i++) {
-            for (int j = 1; j < graf.matriceAdiacenta[i].size(); j++) {
-                out << i << " " << graf.matriceAdiacenta[i][j] << '\n';
+
+        long long valoare = 0;
+        size_t inceputCifre = pozitie;
+        while (pozitie < lungime && (unsigned) (date[pozitie] - '0') < 10) {
+            valoare = valoare * 10 + (date[pozitie] - '0');
+            pozitie++;
+        }
+        if (pozitie == inceputCifre) {
+            esuat = true;
+        }
+        x = negativ ? -valoare : valoare;
+        return *this;
+    }
+
+    CititorRapid &operator>>(bool &x) {
+        int y;
+        *this >> y;
+        x = y != 0;
+        return *this;
+    }
+
+    // citeste urmatorul caracter care nu este spatiu
+    CititorRapid &operator>>(char &c) {
+        while (pozitie < lungime && isspace((unsigned char) date[pozitie])) {
+            pozitie++;
+        }
+        if (pozitie == lungime) {
+            esuat = true;
+        }
+        c = pozitie < lungime ? date[pozitie++] : '\0';
+        return *this;
+    }
+};
+
+/*
+ * Deschide fisierul si il mapeaza in memorie
+ * numeFisier = calea catre fisier
+ * accesSecvential = true daca fisierul va fi citit de la inceput la sfarsit (activeaza read-ahead)
+ */
+CititorRapid::CititorRapid(const char *numeFisier, const bool accesSecvential) {
+#ifdef CITITOR_MMAP
+    int fd = open(numeFisier, O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *mapare = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapare != MAP_FAILED) {
+                madvise(mapare, info.st_size, accesSecvential ? MADV_SEQUENTIAL : MADV_RANDOM);
+                date = (const char *) mapare;
+                lungime = info.st_size;
+                esteMapat = true;
             }
         }
-        return out;
+        close(fd);
+        deschis = true;
+        if (esteMapat) {
+            return;
+        }
+    }
+#endif
+    // varianta de rezerva: citim tot fisierul intr-un buffer mare
+    FILE *fisier = fopen(numeFisier, "rb");
+    if (fisier == nullptr) {
+        return;
     }
+    char bucata[1 << 16];
+    size_t cititi;
+    while ((cititi = fread(bucata, 1, sizeof(bucata), fisier)) > 0) {
+        buffer.insert(buffer.end(), bucata, bucata + cititi);
+    }
+    fclose(fisier);
+    deschis = true;
+    date = buffer.data();
+    lungime = buffer.size();
+}
 
-private:
+CititorRapid::~CititorRapid() {
+#ifdef CITITOR_MMAP
+    if (esteMapat) {
+        munmap((void *) date, lungime);
+    }
+#endif
+}
 
-    void DFS(int nod, vector<int> &vizitate);
+/*
+ * Scriitor rapid folosit de toate functiile care afiseaza rezultate
+ * Textul este pus intr-un buffer mare si scris in fisier doar cand bufferul se umple (sau la distrugere),
+ * iar numerele sunt convertite in text cate doua cifre odata, cu un tabel precalculat
+ * In modul binar numerele sunt scrise direct in formatul nativ (int = 4 octeti), iar separatorii (caractere si
+ * siruri) sunt ignorati, astfel incat "g << x << ' '" produce un vector de numere care poate fi citit de alte programe;
+ * raspunsurile date ca text (de exemplu "DA"/"NU") trebuie scrise ca un cod numeric cand esteBinar() e adevarat
+ * Modul binar se activeaza din linia de comanda cu --binar (vezi main)
+ * Se foloseste la fel ca un ofstream: g << a << ' ' << b << '\n';
+ */
+class ScriitorRapid {
+    FILE *fisier;
+    bool detinutDeScriitor; // true daca fisierul a fost deschis de scriitor si trebuie inchis de el
+    bool binar;
+    vector<char> buffer;
+    size_t folosit = 0;
+
+    void golire() {
+        if (fisier != nullptr && folosit > 0) {
+            fwrite(buffer.data(), 1, folosit, fisier);
+        }
+        folosit = 0;
+    }
 
-    void MuchieCritica(int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
-                       vector<vector<int>> &result);
+    void scriereOcteti(const char *date, size_t lungime) {
+        if (folosit + lungime > buffer.size()) {
+            golire();
+            if (lungime > buffer.size()) {
+                if (fisier != nullptr) {
+                    fwrite(date, 1, lungime, fisier);
+                }
+                return;
+            }
+        }
+        memcpy(buffer.data() + folosit, date, lungime);
+        folosit += lungime;
+    }
 
-    void sortare_topologica(int nod, vector<int> &vizitate, vector<int> &result);
+    // scrie in text numarul fara semn x
+    void scriereNumar(unsigned long long x) {
+        static const char cifrePerechi[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+        char cifre[20];
+        int poz = 20;
+        while (x >= 100) {
+            int r = (int) (x % 100) * 2;
+            x /= 100;
+            cifre[--poz] = cifrePerechi[r + 1];
+            cifre[--poz] = cifrePerechi[r];
+        }
+        if (x >= 10) {
+            cifre[--poz] = cifrePerechi[x * 2 + 1];
+            cifre[--poz] = cifrePerechi[x * 2];
+        } else {
+            cifre[--poz] = (char) ('0' + x);
+        }
+        scriereOcteti(cifre + poz, 20 - poz);
+    }
 
-    int gasesteRadacina(int x, vector<int> &parinte);
+public:
+    // valoarea implicita pentru modul binar al scriitorilor deschisi pe fisiere
+    static bool iesireBinara;
 
-    int interogareCompresie(int x, vector<int> &parinte);
+    explicit ScriitorRapid(const char *numeFisier, bool binar = iesireBinara, size_t dimensiuneBuffer = 1 << 20)
+            : fisier(fopen(numeFisier, binar ? "wb" : "w")), detinutDeScriitor(true), binar(binar),
+              buffer(dimensiuneBuffer) {}
 
-    void reuniune(int x, int y, vector<int> &parinte, vector<int> &rang);
+    // scriitor pe un fisier deja deschis (de exemplu stdout), in mod text
+    explicit ScriitorRapid(FILE *fisier, size_t dimensiuneBuffer = 1 << 16)
+            : fisier(fisier), detinutDeScriitor(false), binar(false), buffer(dimensiuneBuffer) {}
+
+    ScriitorRapid(const ScriitorRapid &) = delete;
+
+    ScriitorRapid &operator=(const ScriitorRapid &) = delete;
+
+    ~ScriitorRapid() {
+        golire();
+        if (fisier != nullptr && detinutDeScriitor) {
+            fclose(fisier);
+        } else if (fisier != nullptr) {
+            fflush(fisier);
+        }
+    }
+
+    // scrie imediat tot ce este in buffer (de exemplu dupa fiecare raspuns, intr-o sesiune interactiva)
+    void scriere() {
+        golire();
+        if (fisier != nullptr) {
+            fflush(fisier);
+        }
+    }
+
+    bool esteDeschis() const {
+        return fisier != nullptr;
+    }
+
+    bool esteBinar() const {
+        return binar;
+    }
+
+    template<typename T>
+    typename enable_if<is_integral<T>::value && !is_same<T, char>::value && !is_same<T, bool>::value,
+            ScriitorRapid &>::type operator<<(const T x) {
+        if (binar) {
+            scriereOcteti((const char *) &x, sizeof(x));
+        } else if (x < 0) {
+            scriereOcteti("-", 1);
+            scriereNumar(0ULL - (unsigned long long) x);
+        } else {
+            scriereNumar((unsigned long long) x);
+        }
+        return *this;
+    }
+
+    ScriitorRapid &operator<<(const char c) {
+        if (!binar) {
+            scriereOcteti(&c, 1);
+        }
+        return *this;
+    }
+
+    ScriitorRapid &operator<<(const char *sir) {
+        if (!binar) {
+            scriereOcteti(sir, strlen(sir));
+        }
+        return *this;
+    }
 };
 
+bool ScriitorRapid::iesireBinara = false;
+
 /*
- * Constructor cu toti parametrii
- * nrNodurie = numarul de noduri ale grafului
- * matriceAdiacenta = matricea de adiacenta a grafului
- * esteOrientat = true -> graful este orientat; false -> graful este neorientat
+ * Generator pseudo-aleator xorshift64, folosit de generatoarele de grafuri sintetice si de
+ * algoritmii care esantioneaza noduri, pentru rezultate reproductibile
  */
-Graf::Graf(const int nrNoduri, const vector<vector<int>> &matriceAdiacenta, const bool esteOrientat) {
-    this->nrNoduri = nrNoduri;
-    this->matriceAdiacenta = matriceAdiacenta;
-    this->esteOrientat = esteOrientat;
+inline unsigned long long xorshift(unsigned long long &stare) {
+    stare ^= stare << 13, stare ^= stare >> 7, stare ^= stare << 17;
+    return stare;
 }
 
 /*
- * Constructor cu toti parametrii
- * nrNodurie = numarul de noduri ale grafului
- * esteOrientat = true -> graful este orientat; false -> graful este neorientat
- * matricea de adiacenta este creata si fiecare linie initiata cu -1
+ * Numarul de fire de executie folosite implicit de algoritmii paraleli
  */
-Graf::Graf(const int nrNoduri, const bool esteOrientat) {
-    this->nrNoduri = nrNoduri;
-    this->esteOrientat = esteOrientat;
+int nrFireImplicit() {
+    unsigned nrFire = thread::hardware_concurrency();
+    return nrFire == 0 ? 1 : (int) nrFire;
+}
 
-    vector<int> v(1, -1);
-    for (int i = 0; i <= nrNoduri; ++i) {
-        matriceAdiacenta.push_back(v);
+/*
+ * Porneste nrFire fire de executie care ruleaza sarcina(fir), fir = 0..nrFire-1, si asteapta terminarea lor
+ * Firul 0 ruleaza pe firul apelant
+ */
+void executieParalela(const int nrFire, const function<void(int)> &sarcina) {
+    vector<thread> fire;
+    for (int fir = 1; fir < nrFire; fir++) {
+        fire.emplace_back(sarcina, fir);
+    }
+    sarcina(0);
+    for (auto &it: fire) {
+        it.join();
     }
 }
 
 /*
- * Constructor de copiere care copiaza din obiectul primit ca parametru in obiectul curent
- * graf = obiect de tipul Graf din care va fi copiat
+ * Bariera reutilizabila pentru nrFire fire de executie: asteptare() se intoarce doar dupa ce toate firele au ajuns la ea
+ * Folosita de algoritmii paraleli care lucreaza pe niveluri (fiecare nivel incepe dupa ce precedentul s-a terminat)
  */
-Graf::Graf(const Graf &graf) {
-    this->nrNoduri = graf.nrNoduri;
-    this->esteOrientat = graf.esteOrientat;
-    this->matriceAdiacenta.clear();
-    this->matriceAdiacenta = graf.matriceAdiacenta;
-}
+class BarieraFire {
+    mutex blocare;
+    condition_variable conditie;
+    int nrFire, nrAsteptari = 0;
+    long long generatie = 0;
+
+public:
+    explicit BarieraFire(int nrFire) : nrFire(nrFire) {}
+
+    void asteptare() {
+        unique_lock<mutex> garda(blocare);
+        long long generatieCurenta = generatie;
+        if (++nrAsteptari == nrFire) {
+            nrAsteptari = 0;
+            generatie++;
+            conditie.notify_all();
+        } else {
+            conditie.wait(garda, [&]() { return generatie != generatieCurenta; });
+        }
+    }
+};
 
 /*
- * Citeste o pereche x,y si adauga in matricea de adiacenta muchiile/arcele citite
- * in = stream-ul de intrare
- * nrMuchii = numarul de muchii/arce citite
+ * Spatiu de lucru refolosibil pentru parcurgeri, cate unul (de fapt NR_SPATII) pentru fiecare fir de executie
+ * Un nod este "vizitat" daca marcaj[nod] == epoca, asa ca golirea intre doua parcurgeri inseamna doar epoca++ (O(1)),
+ * iar vectorii sunt alocati o singura data, la dimensiunea celui mai mare graf parcurs de fir
+ * valoare si parinte sunt valide doar pentru nodurile vizitate in parcurgerea curenta, iar lista este un buffer
+ * (coada sau stiva) golit la fiecare pregatire
+ * Astfel o interogare repetata costa O(noduri vizitate) in loc de O(n)
+ * Un algoritm care foloseste spatiul unui fir nu trebuie sa apeleze alt algoritm care foloseste acelasi spatiu;
+ * de aceea fiecare fir are NR_SPATII spatii, alese prin parametrul lui alFirului
  */
-void Graf::citireGraf(istream &in, const int nrMuchii) {
-    int x, y;
-    for (int i = 0; i < nrMuchii; i++) {
-        in >> x >> y;
-        matriceAdiacenta[x].push_back(y);
-        if (!esteOrientat) {
-            matriceAdiacenta[y].push_back(x);
+class SpatiuLucru {
+    vector<unsigned int> marcaj;
+    unsigned int epoca = 0;
+
+public:
+    static const int NR_SPATII = 2;
+
+    vector<int> valoare;
+    vector<int> parinte;
+    vector<int> lista;
+
+    // pregateste spatiul pentru o parcurgere noua pe un graf cu nrNoduri noduri (numerotate de la 1)
+    void pregatire(const int nrNoduri) {
+        if (marcaj.size() < (size_t) nrNoduri + 1) {
+            marcaj.assign(nrNoduri + 1, 0);
+            valoare.resize(nrNoduri + 1);
+            parinte.resize(nrNoduri + 1);
+            epoca = 0;
         }
+        if (++epoca == 0) { // dupa 2^32 parcurgeri marcajele vechi ar putea fi confundate cu epoca curenta
+            fill(marcaj.begin(), marcaj.end(), 0);
+            epoca = 1;
+        }
+        lista.clear();
     }
-}
+
+    bool vizitat(const int nod) const {
+        return marcaj[nod] == epoca;
+    }
+
+    void vizitare(const int nod) {
+        marcaj[nod] = epoca;
+    }
+
+    static SpatiuLucru &alFirului(const int index = 0) {
+        thread_local SpatiuLucru spatii[NR_SPATII];
+        return spatii[index];
+    }
+};
+
+const int SpatiuLucru::NR_SPATII;
 
 /*
- * Addauga o muchie in graf
- * startNode = nodul din care porneste muchi
- * endNode = nodul in care ajunge muchia
- * In functie de tipul de graf, este actualizata matricea de adiacenta
+ * Cadru al stivei explicite folosite de parcurgereDFS: nodul, parintele lui in arborele DFS (0 pentru radacina)
+ * si pozitia urmatorului vecin de examinat in lista nodului
  */
-void Graf::adaugareMuchie(const int startNode, const int endNode) {
-    if (!this->esteOrientat) {
-        this->matriceAdiacenta[startNode].push_back(endNode);
-        this->matriceAdiacenta[endNode].push_back(startNode);
-    } else {
-        this->matriceAdiacenta[startNode].push_back(endNode);
+struct CadruDFS {
+    int nod;
+    int parinte;
+    long long pozitie;
+};
+
+/*
+ * Evenimentele parcurgerii DFS iterative (Graf::parcurgereDFS), implicit fara efect
+ * Un vizitator concret mosteneste aceasta structura, defineste vizitat(nod) si marcare(nod) si suprascrie doar
+ * evenimentele de care are nevoie; apelurile sunt rezolvate la compilare, deci evenimentele goale nu costa nimic
+ * muchieArbore(nod, fiu, pozitie) = vecinul de pe pozitia data din lista nodului este nevizitat si devine fiul lui
+ * intrare(nod, parinte) = nodul tocmai a fost marcat (pre-ordine), parinte = 0 pentru radacina
+ * muchieInapoi(nod, vecin, pozitie) = vecinul de pe pozitia data din lista nodului era deja vizitat
+ * revenire(nod, fiu, pozitie) = s-a terminat subarborele fiului, atins prin vecinul de pe pozitia data
+ * iesire(nod, parinte) = toti vecinii nodului au fost examinati (post-ordine)
+ */
+struct VizitatorDFS {
+    void muchieArbore(int, int, long long) {}
+
+    void intrare(int, int) {}
+
+    void muchieInapoi(int, int, long long) {}
+
+    void revenire(int, int, long long) {}
+
+    void iesire(int, int) {}
+};
+
+// vizitator care marcheaza nodurile intr-un vector (vizitate[nod] = 1)
+struct VizitatorVector : VizitatorDFS {
+    vector<int> &vizitate;
+
+    explicit VizitatorVector(vector<int> &vizitate) : vizitate(vizitate) {}
+
+    bool vizitat(const int nod) const {
+        return vizitate[nod] != 0;
     }
-}
 
-void Graf::eliminareMuchie(const int startNode, const int endNode) {
-    int len = this->matriceAdiacenta[startNode].size();
-    for (int i = 1; i < len; i++) {
-        if (this->matriceAdiacenta[startNode][i] == endNode) {
-            this->matriceAdiacenta[startNode][i] = this->matriceAdiacenta[startNode][len - 1];
-            this->matriceAdiacenta[startNode].pop_back();
-        }
+    void marcare(const int nod) {
+        vizitate[nod] = 1;
     }
+};
 
-    if (!esteOrientat) {
-        len = this->matriceAdiacenta[endNode].size();
-        for (int i = 0; i < len; i++) {
-            if (this->matriceAdiacenta[endNode][i] == startNode) {
-                this->matriceAdiacenta[endNode][i] = this->matriceAdiacenta[endNode][len - 1];
-                this->matriceAdiacenta[endNode].pop_back();
-            }
-        }
+// vizitator care marcheaza nodurile in spatiul de lucru
+struct VizitatorSpatiu : VizitatorDFS {
+    SpatiuLucru &spatiu;
+
+    explicit VizitatorSpatiu(SpatiuLucru &spatiu) : spatiu(spatiu) {}
+
+    bool vizitat(const int nod) const {
+        return spatiu.vizitat(nod);
     }
-}
 
-void Graf::bfs_marmelada(int start, vector<vector<pair<int, int>>> &matriceAdiacenta2, vector<int> &vizitate,
-                         vector<int> &muchii) {
+    void marcare(const int nod) {
+        spatiu.vizitare(nod);
+    }
+};
 
-    // Queue in care salvam elementele care trebuiesc vizitate. Cand se goleste, nu mai avem nimic de vizitat
-    queue<int> queue;
-    queue.push(start);
-    vizitate[start] = -1;
+/*
+ * Vizitator pentru algoritmul lui Tarjan (componente tare conexe)
+ * index[nod] = momentul vizitarii (0 = nevizitat), minim[nod] = cel mai mic index al unui nod inca aflat pe stiva,
+ * atins din subarborele lui nod; cand minim[nod] == index[nod], nodurile de pe stiva de deasupra lui nod (inclusiv)
+ * formeaza o componenta, a carei eticheta este nod (radacina ei in arborele DFS)
+ * radacini = radacinile componentelor in ordinea gasirii: o componenta este gasita dupa toate cele in care are arce
+ * Un nod cu index[nod] = -1 inainte de parcurgere este ignorat (considerat vizitat si scos de pe stiva)
+ */
+struct VizitatorTarjan : VizitatorDFS {
+    vector<int> index, minim, eticheta, stiva, radacini;
+    vector<char> peStiva;
+    int t = 0;
 
-    while (!queue.empty()) {
-        int nodUrm = queue.front();
-        queue.pop();
-        for (int i = 0; i < matriceAdiacenta2[nodUrm].size(); i++) { // parcurgem fiecare nod adiacent al nodului curent
-            int nod = matriceAdiacenta2[nodUrm][i].first;
-            int muchie = matriceAdiacenta2[nodUrm][i].second;
-            // Daca nu a fost vizitat inca
-            if (!vizitate[nod]) {
-                vizitate[nod] = nodUrm;
-                muchii[nod] = muchie;
-                queue.push(nod); // Il adaugam in coada pentru a fi vizitat
-            }
+    explicit VizitatorTarjan(const int nrNoduri)
+            : index(nrNoduri + 1, 0), minim(nrNoduri + 1), eticheta(nrNoduri + 1, 0), peStiva(nrNoduri + 1, 0) {}
+
+    bool vizitat(const int nod) const {
+        return index[nod] != 0;
+    }
+
+    void marcare(const int nod) {
+        index[nod] = minim[nod] = ++t;
+        stiva.push_back(nod);
+        peStiva[nod] = 1;
+    }
+
+    void muchieInapoi(const int nod, const int vecin, long long) {
+        if (peStiva[vecin]) {
+            minim[nod] = min(minim[nod], index[vecin]);
+        }
+    }
+
+    void revenire(const int nod, const int fiu, long long) {
+        minim[nod] = min(minim[nod], minim[fiu]);
+    }
+
+    void iesire(const int nod, int) {
+        if (minim[nod] != index[nod]) {
+            return;
+        }
+        int membru;
+        do {
+            membru = stiva.back();
+            stiva.pop_back();
+            peStiva[membru] = 0;
+            eticheta[membru] = nod;
+        } while (membru != nod);
+        radacini.push_back(nod);
+    }
+};
+
+/*
+ * Puntile unui graf neorientat la care muchiile sunt doar adaugate, mentinute incremental
+ * Nodurile sunt grupate in clase 2-muchie-conexe (DSU clasa); clasele formeaza o padure in care fiecare legatura
+ * clasa -> parinte este o punte, iar componentele conexe ale padurii sunt tinute intr-un al doilea DSU (componenta)
+ * La adaugarea unei muchii x-y:
+ *   - daca x si y sunt in aceeasi clasa nu se schimba nimic
+ *   - daca sunt in componente diferite, arborele mai mic este rearanjat cu radacina in clasa lui x si agatat de y
+ *     (muchia devine punte); fiecare nod isi schimba radacina de O(log n) ori
+ *   - altfel drumul dintre cele doua clase din padure inchide un ciclu: clasele de pe drum sunt unite, iar puntile
+ *     de pe el dispar; drumul este gasit urcand alternativ din ambele capete pana la primul nod comun
+ * Costul amortizat este O(log n) pe muchie (practic constant), fata de o parcurgere completa a grafului
+ */
+class PuntiIncrementale {
+    vector<int> clasa;          // DSU peste clasele 2-muchie-conexe
+    vector<int> componenta;     // DSU peste componentele conexe, pe reprezentantii claselor
+    vector<int> dimensiune;     // dimensiune[radacina] = numarul de clase din arborele ei
+    vector<int> parinte;        // parinte[c] = un nod din clasa parinte a clasei c in padure (0 pentru radacina)
+    vector<int> capatJos, capatSus; // capetele puntii dintre clasa c si parintele ei
+    vector<int> ultimaVizita;
+    vector<int> drumA, drumB;
+    int iteratie = 0;
+    int nrPunti = 0;
+
+    int gasesteClasa(int nod) {
+        int radacina = nod;
+        while (clasa[radacina] != radacina) {
+            radacina = clasa[radacina];
+        }
+        while (clasa[nod] != radacina) {
+            int urmator = clasa[nod];
+            clasa[nod] = radacina;
+            nod = urmator;
+        }
+        return radacina;
+    }
+
+    int gasesteComponenta(int nod) {
+        nod = gasesteClasa(nod);
+        int radacina = nod;
+        while (componenta[radacina] != radacina) {
+            radacina = componenta[radacina];
+        }
+        while (componenta[nod] != radacina) {
+            int urmator = componenta[nod];
+            componenta[nod] = radacina;
+            nod = urmator;
+        }
+        return radacina;
+    }
+
+    // inverseaza legaturile de pe drumul de la clasa lui nod la radacina, astfel incat clasa lui nod devine radacina
+    void reinradacinare(int nod) {
+        nod = gasesteClasa(nod);
+        int radacina = nod, copil = 0, josCopil = 0, susCopil = 0;
+        while (nod != 0) {
+            int urmator = parinte[nod] == 0 ? 0 : gasesteClasa(parinte[nod]);
+            int jos = capatJos[nod], sus = capatSus[nod];
+            parinte[nod] = copil;
+            capatJos[nod] = susCopil, capatSus[nod] = josCopil; // puntea catre fostul copil, vazuta de sus in jos
+            componenta[nod] = radacina;
+            copil = nod, josCopil = jos, susCopil = sus;
+            nod = urmator;
+        }
+        dimensiune[radacina] = dimensiune[copil];
+    }
+
+    // uneste toate clasele de pe drumul dintre clasele lui a si b (aflate in acelasi arbore)
+    void unireDrum(int a, int b) {
+        iteratie++;
+        drumA.clear();
+        drumB.clear();
+        int stramos = 0;
+        while (stramos == 0) {
+            if (a != 0) {
+                a = gasesteClasa(a);
+                drumA.push_back(a);
+                if (ultimaVizita[a] == iteratie) {
+                    stramos = a;
+                    break;
+                }
+                ultimaVizita[a] = iteratie;
+                a = parinte[a];
+            }
+            if (b != 0) {
+                b = gasesteClasa(b);
+                drumB.push_back(b);
+                if (ultimaVizita[b] == iteratie) {
+                    stramos = b;
+                    break;
+                }
+                ultimaVizita[b] = iteratie;
+                b = parinte[b];
+            }
+        }
+        for (vector<int> *drum: {&drumA, &drumB}) {
+            for (int c: *drum) {
+                clasa[c] = stramos;
+                if (c == stramos) {
+                    break;
+                }
+                nrPunti--;
+            }
+        }
+    }
+
+public:
+    explicit PuntiIncrementale(const int nrNoduri = 0)
+            : clasa(nrNoduri + 1), componenta(nrNoduri + 1), dimensiune(nrNoduri + 1, 1), parinte(nrNoduri + 1, 0),
+              capatJos(nrNoduri + 1, 0), capatSus(nrNoduri + 1, 0), ultimaVizita(nrNoduri + 1, 0) {
+        for (int nod = 0; nod <= nrNoduri; nod++) {
+            clasa[nod] = componenta[nod] = nod;
+        }
+    }
+
+    void adaugareMuchie(const int x, const int y) {
+        int a = gasesteClasa(x), b = gasesteClasa(y);
+        if (a == b) {
+            return;
+        }
+        int ca = gasesteComponenta(a), cb = gasesteComponenta(b);
+        if (ca != cb) {
+            nrPunti++;
+            int jos = x, sus = y;
+            if (dimensiune[ca] > dimensiune[cb]) {
+                swap(a, b), swap(ca, cb), swap(jos, sus);
+            }
+            reinradacinare(a);
+            parinte[a] = componenta[a] = b;
+            capatJos[a] = jos, capatSus[a] = sus;
+            dimensiune[cb] += dimensiune[a];
+        } else {
+            unireDrum(a, b);
+        }
+    }
+
+    // true daca x-y este una dintre muchiile adaugate si este punte
+    bool estePunte(const int x, const int y) {
+        int a = gasesteClasa(x), b = gasesteClasa(y);
+        if (a == b) {
+            return false;
+        }
+        if (parinte[a] == 0 || gasesteClasa(parinte[a]) != b) {
+            swap(a, b);
+            if (parinte[a] == 0 || gasesteClasa(parinte[a]) != b) {
+                return false;
+            }
+        }
+        return (capatJos[a] == x && capatSus[a] == y) || (capatJos[a] == y && capatSus[a] == x);
+    }
+
+    int numarPunti() const {
+        return nrPunti;
+    }
+};
+
+/*
+ * Ordine topologica a unui graf orientat aciclic la care arcele sunt doar adaugate, mentinuta incremental
+ * (Pearce-Kelly): pozitie[nod] este locul nodului in ordine, iar nodPePozitie este ordinea insasi
+ * La adaugarea unui arc x -> y:
+ *   - daca x este deja inaintea lui y nu se schimba nimic
+ *   - altfel sunt cautate doar nodurile dintre pozitiile lui y si x: cele atinse din y (inainte) si cele din care
+ *     se ajunge in x (inapoi); daca cautarea inainte ajunge in x, arcul ar inchide un ciclu si este refuzat
+ *   - nodurile gasite isi impart intre ele aceleasi pozitii: intai cele de inapoi, apoi cele de inainte, fiecare
+ *     grup pastrandu-si ordinea relativa; restul ordinii ramane neatins
+ * Costul unei adaugari depinde doar de regiunea afectata, nu de dimensiunea grafului
+ */
+class OrdineTopologicaIncrementala {
+    vector<int> pozitie, nodPePozitie;
+    vector<vector<int>> succesori, predecesori;
+    vector<int> ultimaVizita;
+    vector<int> stiva, inainte, inapoi, pozitiiLibere;
+    int iteratie = 0;
+
+    // nodurile atinse din start (sau care ating start, daca inapoi) cu pozitia in [limitaJos, limitaSus]
+    // Returneaza false daca este atins nodul oprire
+    bool cautare(const int start, const vector<vector<int>> &vecini, const int limitaJos, const int limitaSus,
+                 const int oprire, vector<int> &gasite) {
+        gasite.clear();
+        stiva.assign(1, start);
+        ultimaVizita[start] = iteratie;
+        while (!stiva.empty()) {
+            int nod = stiva.back();
+            stiva.pop_back();
+            gasite.push_back(nod);
+            for (int vecin: vecini[nod]) {
+                if (vecin == oprire) {
+                    return false;
+                }
+                if (ultimaVizita[vecin] != iteratie && pozitie[vecin] >= limitaJos && pozitie[vecin] <= limitaSus) {
+                    ultimaVizita[vecin] = iteratie;
+                    stiva.push_back(vecin);
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    // ordinea initiala poate fi orice permutare a nodurilor 1..nrNoduri (implicit 1, 2, ..., nrNoduri)
+    explicit OrdineTopologicaIncrementala(const int nrNoduri = 0, const vector<int> &ordine = {})
+            : pozitie(nrNoduri + 1, -1), nodPePozitie(ordine), succesori(nrNoduri + 1), predecesori(nrNoduri + 1),
+              ultimaVizita(nrNoduri + 1, 0) {
+        if (nodPePozitie.empty()) {
+            for (int nod = 1; nod <= nrNoduri; nod++) {
+                nodPePozitie.push_back(nod);
+            }
+        }
+        for (int i = 0; i < (int) nodPePozitie.size(); i++) {
+            pozitie[nodPePozitie[i]] = i;
+        }
+    }
+
+    // Adauga arcul x -> y si reordoneaza regiunea afectata; daca arcul ar inchide un ciclu nu este adaugat
+    // si este returnat false
+    bool adaugareArc(const int x, const int y) {
+        if (x == y) {
+            return false;
+        }
+        if (pozitie[x] > pozitie[y]) {
+            iteratie++;
+            int limitaJos = pozitie[y], limitaSus = pozitie[x];
+            if (!cautare(y, succesori, limitaJos, limitaSus, x, inainte)) {
+                return false;
+            }
+            cautare(x, predecesori, limitaJos, limitaSus, 0, inapoi);
+
+            auto dupaPozitie = [&](int a, int b) {
+                return pozitie[a] < pozitie[b];
+            };
+            sort(inainte.begin(), inainte.end(), dupaPozitie);
+            sort(inapoi.begin(), inapoi.end(), dupaPozitie);
+            pozitiiLibere.clear();
+            merge(inapoi.begin(), inapoi.end(), inainte.begin(), inainte.end(), back_inserter(pozitiiLibere),
+                  dupaPozitie);
+            for (int &it: pozitiiLibere) {
+                it = pozitie[it];
+            }
+            int i = 0;
+            for (vector<int> *grup: {&inapoi, &inainte}) {
+                for (int nod: *grup) {
+                    pozitie[nod] = pozitiiLibere[i++];
+                    nodPePozitie[pozitie[nod]] = nod;
+                }
+            }
+        }
+        succesori[x].push_back(y);
+        predecesori[y].push_back(x);
+        return true;
+    }
+
+    // Scoate o aparitie a arcului x -> y; ordinea ramane valabila fara nicio schimbare
+    void eliminareArc(const int x, const int y) {
+        auto stergere = [](vector<int> &lista, int vecin) {
+            auto it = find(lista.begin(), lista.end(), vecin);
+            if (it != lista.end()) {
+                *it = lista.back();
+                lista.pop_back();
+            }
+        };
+        stergere(succesori[x], y);
+        stergere(predecesori[y], x);
+    }
+
+    int pozitieNod(const int nod) const {
+        return pozitie[nod];
+    }
+
+    const vector<int> &ordine() const {
+        return nodPePozitie;
+    }
+};
+
+class Graf {
+    int nrNoduri = 0; // numarul de noduri ale grafului
+    vector<vector<int>> matriceAdiacenta; // matrice de adiacenta( un vector de vectori; primul element din fiecare vector este -1 )
+    bool esteOrientat = false; // esteOrientat = true -> graf orientat esle -> graf neorientat
+    bool areCosturi = false; // true daca muchiile grafului au costuri
+    // costuriAdiacenta[nod][i] = costul muchiei catre matriceAdiacenta[nod][i] (pe pozitia 0 se afla 0, ca santinela)
+    // costurile sunt tinute separat de vecini pentru ca parcurgerile fara costuri (BFS, DFS) sa nu le incarce in cache
+    vector<vector<int>> costuriAdiacenta;
+
+    // Fiecare muchie are un id (0, 1, 2, ... in ordinea adaugarii)
+    // idMuchiiAdiacenta[nod][i] = id-ul muchiei catre matriceAdiacenta[nod][i] (pe pozitia 0 se afla -1, ca santinela)
+    // capeteMuchie[2 * id] si capeteMuchie[2 * id + 1] = nodul de start si nodul de final al muchiei id
+    // pozitieMuchie[2 * id + capat] = pozitia muchiei in lista de adiacenta a capatului (0 daca muchia a fost eliminata)
+    // Astfel o muchie poate fi eliminata (dupa id) si adaugata la loc in O(1)
+    // Intr-un graf neorientat construit direct in CSR, nodul de start refacut de dezghetare este cel mai mic capat
+    int nrMuchii = 0;
+    vector<vector<int>> idMuchiiAdiacenta;
+    vector<int> capeteMuchie;
+    vector<int> pozitieMuchie;
+    vector<int> costMuchiiEliminate; // costul pe care il primeste o muchie eliminata cand este adaugata la loc
+
+    // Reprezentarea CSR (compressed sparse row) in care graful poate fi "inghetat" dupa citire
+    // vecinii nodului nod se afla in listaVecini pe pozitiile [inceputVecini[nod], inceputVecini[nod + 1])
+    bool esteInghetat = false;
+    vector<long long> inceputVecini;
+    vector<int> listaVecini;
+    vector<int> listaCosturi; // listaCosturi[k] = costul muchiei catre listaVecini[k]
+    vector<int> listaIdMuchii; // listaIdMuchii[k] = id-ul muchiei catre listaVecini[k]
+    // parcurgerile citesc CSR-ul prin acesti pointeri: ei indica fie in vectorii de mai sus,
+    // fie direct in fisierul binar mapat in memorie (fisierMapat), fara nicio copiere
+    const long long *csrInceput = nullptr;
+    const int *csrVecini = nullptr;
+    const int *csrCosturi = nullptr;
+    const int *csrIdMuchii = nullptr;
+    shared_ptr<CititorRapid> fisierMapat;
+
+    // Transpusul unui graf orientat, tot in forma CSR: arcele care intra in nod se afla in listaTranspus pe pozitiile
+    // [inceputTranspus[nod], inceputTranspus[nod + 1]). Este construit la prima nevoie si invalidat la orice modificare
+    // Constructia este facuta o singura data, sub mutexTranspus, deci interogarile care au nevoie de transpus pot fi
+    // apelate in paralel pe acelasi graf (ca orice interogare, nu in paralel cu o modificare a grafului)
+    vector<long long> inceputTranspus;
+    vector<int> listaTranspus;
+    atomic<bool> transpusConstruit{false};
+    mutex mutexTranspus;
+
+    // puntile mentinute incremental (dupa urmarirePunti): adaugarile de muchii le actualizeaza direct,
+    // iar dupa o eliminare sau o reincarcare a grafului sunt reconstruite la urmatoarea interogare
+    PuntiIncrementale puntiIncrementale;
+    bool urmarestePunti = false;
+    bool puntiActuale = false;
+
+    // ordinea topologica mentinuta incremental (dupa urmarireOrdineTopologica): adaugarile si eliminarile de arce
+    // o actualizeaza direct, iar arcele care ar inchide un ciclu sunt refuzate de adaugareMuchie
+    // grafCuCiclu = true daca graful avea deja un ciclu la reconstructie (atunci nu este refuzat niciun arc, iar
+    // dupa prima eliminare ordinea este reconstruita, pentru ca eliminarea poate rupe ciclul)
+    OrdineTopologicaIncrementala ordineIncrementala;
+    bool urmaresteOrdinea = false;
+    bool ordineActuala = false;
+    bool grafCuCiclu = false;
+
+public:
+    Graf(int nrNoduri, const vector<vector<int>> &matriceAdiacenta, bool esteOrientat);
+
+    Graf(int nrNoduri, bool esteOrientat);
+
+    Graf(int nrNoduri, const vector<pair<int, int>> &muchii, bool esteOrientat, const vector<int> &costuri = {},
+         int nrFire = 0);
+
+    Graf(const Graf &graf);
+
+    Graf() {};
+
+    Graf &operator=(const Graf &graf);
+
+    void citireGraf(istream &in, int nrMuchii);
+
+    void citireGraf(CititorRapid &in, int nrMuchii);
+
+    void citireGrafCosturi(CititorRapid &in, int nrMuchii);
+
+    int adaugareMuchie(int startNode, int endNode);
+
+    int adaugareMuchie(int startNode, int endNode, int cost);
+
+    void eliminareMuchie(int startNode, int endNode);
+
+    void eliminareMuchieId(int id);
+
+    void reinserareMuchie(int id);
+
+    int numarMuchii() const {
+        return nrMuchii;
+    }
+
+    int numarNoduri() const {
+        return nrNoduri;
+    }
+
+    bool orientat() const {
+        return esteOrientat;
+    }
+
+    vector<vector<int>> muchiiCuCosturi();
+
+    void inghetare();
+
+    void dezghetare();
+
+    bool inghetat() const {
+        return esteInghetat;
+    }
+
+    bool salvareBinar(const char *numeFisier);
+
+    bool incarcareBinar(const char *numeFisier);
+
+    vector<int> distantaMinimaBFS(ostream &out, int start);
+
+    vector<int> distantaMinimaBFS(int start);
+
+    vector<int> distantaMinimaBFSHibrid(int start);
+
+    vector<int> distantaMinimaBFSParalel(int start, int nrFire = 0);
+
+    vector<int> distantaMinimaBFSMultiSursa(const vector<int> &surse, vector<int> &sursaApropiata);
+
+    vector<vector<int>> distanteBitParalel(const vector<int> &surse);
+
+    vector<int> drumMinimBFS(int start, int final);
+
+    vector<int> excentricitati(int nrFire = 0);
+
+    int BFS_amici2(int start, vector<vector<int>> &matriceAdiacenta);
+
+    void bfs_marmelada(int start, vector<int> &vizitate, vector<int> &muchii);
+
+    int componenteConexe();
+
+    int componenteConexeRecursiv(vector<int> &vizitate, int startPos = 1);
+
+    int componenteConexeParalel(vector<int> &componenta, int nrFire = 0);
+
+    vector<vector<int>> muchiiCritice_neeficient();
+
+    vector<vector<int>> DFS_muchiiCritice();
+
+    void puntiSiArticulatii(vector<int> &punti, vector<int> &articulatii);
+
+    void urmarirePunti();
+
+    bool estePunte(int x, int y);
+
+    int numarPunti();
+
+    bool urmarireOrdineTopologica();
+
+    int pozitieTopologica(int nod);
+
+    const vector<int> &ordineTopologicaCurenta();
+
+    Graf componenteBiconexe(vector<int> &blocMuchie, vector<int> &articulatii);
+
+    Graf componenteTareConexe(vector<int> &componenta);
+
+    Graf componenteTareConexeParalel(vector<int> &componenta, int nrFire = 0);
+
+    vector<int> DFS_sortareTopologica(ostream &out);
+
+    vector<int> DFS_sortareTopologica();
+
+    vector<int> DFS_sortareTopologica(vector<int> &ciclu);
+
+    int sortareTopologicaParalel(vector<int> &ordine, vector<int> &nivel, vector<int> &ciclu, int nrFire = 0);
+
+    int disjoint(int cod, int x, int y, vector<int> &parinte, vector<int> &rang);
+
+    vector<int> dijkstra(int nodStart);
+
+    vector<int> bellman_ford(int nodStart);
+
+    void DFS_darb(int nod, vector<int> &vizitate, int &adancime, int &adancimeMax, int &nodAdancimeMax);
+
+    vector<int> Euler();
+
+    vector<vector<int>> APM(vector<vector<int>> muchii);
+
+    int hamilton();
+
+    void setMatriceAdiacenta(const vector<vector<int>> &matriceAdiacenta2) {
+        incarcareMatrice(matriceAdiacenta2);
+    }
+
+    void dfs_pamant(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
+                    vector<int> &result);
+
+    friend istream &operator>>(istream &in, Graf &graf) {
+        cout << "\nEste graf orientat? (1 pentru DA, 0 pentru NU): ";
+        in >> graf.esteOrientat;
+        cout << "\nNumarul de noduri: ";
+        in >> graf.nrNoduri;
+        cout << "\nNumarul de muchii: ";
+        int nrMuchii;
+        in >> nrMuchii;
+        for (int i = 1; i <= nrMuchii; i++) {
+            cout << "Muchia numarul " << i << ": ";
+            int startNode, endNode;
+            in >> startNode >> endNode;
+            graf.adaugareMuchie(startNode, endNode);
+        }
+        return in;
+    }
+
+    // citire fara mesaje, in formatul: esteOrientat nrNoduri nrMuchii urmat de muchii
+    friend CititorRapid &operator>>(CititorRapid &in, Graf &graf) {
+        int nrNoduri, nrMuchii;
+        bool esteOrientat;
+        in >> esteOrientat >> nrNoduri >> nrMuchii;
+        graf = Graf(nrNoduri, esteOrientat);
+        graf.citireGraf(in, nrMuchii);
+        return in;
+    }
+
+    friend ostream &operator<<(ostream &out, Graf &graf) {
+        if (graf.esteOrientat) {
+            out << "Este graf orientat? DA";
+        } else {
+            out << "Este graf orientat? NU";
+        }
+        out << "\nNumar noduri: " << graf.nrNoduri;
+        out << "\nMuchii:\n";
+        for (int i = 1; i <= graf.nrNoduri; i++) {
+            for (const int *it = graf.inceputAdiacenta(i); it != graf.sfarsitAdiacenta(i); it++) {
+                out << i << " " << *it << '\n';
+            }
+        }
+        return out;
+    }
+
+private:
+
+    /*
+     * Intervalul [inceputAdiacenta(nod), sfarsitAdiacenta(nod)) contine vecinii nodului, fara santinela -1
+     * Functioneaza atat pe matricea de adiacenta cat si pe reprezentarea CSR, astfel incat parcurgerile
+     * nu depind de starea grafului
+     */
+    const int *inceputAdiacenta(const int nod) const {
+        if (esteInghetat) {
+            return csrVecini + csrInceput[nod];
+        }
+        return matriceAdiacenta[nod].data() + 1;
+    }
+
+    const int *sfarsitAdiacenta(const int nod) const {
+        if (esteInghetat) {
+            return csrVecini + csrInceput[nod + 1];
+        }
+        return matriceAdiacenta[nod].data() + matriceAdiacenta[nod].size();
+    }
+
+    /*
+     * Costurile muchiilor catre vecinii din intervalul [inceputAdiacenta(nod), sfarsitAdiacenta(nod)), in aceeasi ordine
+     * Returneaza nullptr daca graful nu are costuri (vectorii de costuri nu exista); apelantii folosesc atunci costul 1
+     */
+    const int *inceputCosturi(const int nod) const {
+        if (!areCosturi) {
+            return nullptr;
+        }
+        if (esteInghetat) {
+            return csrCosturi + csrInceput[nod];
+        }
+        return costuriAdiacenta[nod].data() + 1;
+    }
+
+    // id-urile muchiilor catre vecinii din intervalul [inceputAdiacenta(nod), sfarsitAdiacenta(nod)), in aceeasi ordine
+    const int *inceputIdMuchii(const int nod) const {
+        if (esteInghetat) {
+            return csrIdMuchii + csrInceput[nod];
+        }
+        return idMuchiiAdiacenta[nod].data() + 1;
+    }
+
+    /*
+     * Nodurile din care intra o muchie in nod: pentru un graf neorientat sunt chiar vecinii,
+     * pentru unul orientat sunt citite din transpus (constructieTranspus trebuie apelata inainte)
+     */
+    const int *inceputIntrari(const int nod) const {
+        if (!esteOrientat) {
+            return inceputAdiacenta(nod);
+        }
+        return listaTranspus.data() + inceputTranspus[nod];
+    }
+
+    const int *sfarsitIntrari(const int nod) const {
+        if (!esteOrientat) {
+            return sfarsitAdiacenta(nod);
+        }
+        return listaTranspus.data() + inceputTranspus[nod + 1];
+    }
+
+    void constructieTranspus();
+
+    void invalidareTranspus() {
+        if (transpusConstruit.load(memory_order_relaxed)) {
+            vector<long long>().swap(inceputTranspus);
+            vector<int>().swap(listaTranspus);
+            transpusConstruit.store(false, memory_order_relaxed);
+        }
+    }
+
+    void incarcareMatrice(const vector<vector<int>> &matrice);
+
+    int muchieNoua(int startNode, int endNode);
+
+    void adaugareInLista(int nod, int vecin, int id, int capat, int cost);
+
+    void eliminareDinLista(int nod, int pozitie);
+
+    void legareCSR();
+
+    void eliberareCSR();
+
+    void BFSBitParalel(const int *surse, int nrSurse,
+                       const function<void(int nivel, const vector<int> &noduri,
+                                           const vector<unsigned long long> &noi)> &peNivel);
+
+    template<typename Vizitator>
+    void parcurgereDFS(int radacina, Vizitator &vizitator);
+
+    void DFS(int nod, vector<int> &vizitate);
+
+    void DFS(int nod, SpatiuLucru &spatiu);
+
+    void MuchieCritica(int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
+                       vector<vector<int>> &result);
+
+    void sortare_topologica(int nod, vector<int> &vizitate, vector<int> &parinte, vector<int> &result,
+                            vector<int> &ciclu);
+
+    int gasesteRadacina(int x, vector<int> &parinte);
+
+    int interogareCompresie(int x, vector<int> &parinte);
+
+    void reuniune(int x, int y, vector<int> &parinte, vector<int> &rang);
+
+    void reconstructiePunti();
+
+    void reconstructieOrdine();
+
+    void BFSParalelMarcaje(int start, bool inapoi, vector<atomic<int>> &marcaj, int dinStare, int inStare, int nrFire);
+
+    Graf condensare(const vector<int> &componenta, int nrComponente);
+
+    void actualizarePunti(int startNode, int endNode) {
+        if (urmarestePunti && puntiActuale) {
+            puntiIncrementale.adaugareMuchie(startNode, endNode);
+        }
+    }
+
+    // false daca arcul ar inchide un ciclu in ordinea topologica urmarita (altfel arcul este deja inclus in ea)
+    bool acceptareArc(int startNode, int endNode) {
+        if (!urmaresteOrdinea || !esteOrientat) {
+            return true;
+        }
+        if (!ordineActuala) {
+            reconstructieOrdine();
+        }
+        return grafCuCiclu || ordineIncrementala.adaugareArc(startNode, endNode);
+    }
+};
+
+/*
+ * Constructor cu toti parametrii
+ * nrNodurie = numarul de noduri ale grafului
+ * matriceAdiacenta = matricea de adiacenta a grafului
+ * esteOrientat = true -> graful este orientat; false -> graful este neorientat
+ */
+Graf::Graf(const int nrNoduri, const vector<vector<int>> &matriceAdiacenta, const bool esteOrientat) {
+    this->nrNoduri = nrNoduri;
+    this->esteOrientat = esteOrientat;
+    incarcareMatrice(matriceAdiacenta);
+}
+
+/*
+ * Constructor cu toti parametrii
+ * nrNodurie = numarul de noduri ale grafului
+ * esteOrientat = true -> graful este orientat; false -> graful este neorientat
+ * matricea de adiacenta este creata si fiecare linie initiata cu -1
+ */
+Graf::Graf(const int nrNoduri, const bool esteOrientat) {
+    this->nrNoduri = nrNoduri;
+    this->esteOrientat = esteOrientat;
+
+    vector<int> v(1, -1);
+    for (int i = 0; i <= nrNoduri; ++i) {
+        matriceAdiacenta.push_back(v);
+        idMuchiiAdiacenta.push_back(v);
+    }
+}
+
+/*
+ * Inlocuieste muchiile grafului cu cele din matricea de adiacenta primita (cu santinela -1 pe prima pozitie)
+ * Intr-un graf neorientat fiecare muchie x-y apare in ambele liste, deci este adaugata doar o data (cand x <= y)
+ */
+void Graf::incarcareMatrice(const vector<vector<int>> &matrice) {
+    eliberareCSR();
+    puntiActuale = false;
+    ordineActuala = false;
+    areCosturi = false;
+    nrMuchii = 0;
+    capeteMuchie.clear();
+    pozitieMuchie.clear();
+    costMuchiiEliminate.clear();
+    vector<vector<int>>().swap(costuriAdiacenta);
+    matriceAdiacenta.assign(nrNoduri + 1, vector<int>(1, -1));
+    idMuchiiAdiacenta.assign(nrNoduri + 1, vector<int>(1, -1));
+
+    for (int nod = 1; nod <= nrNoduri && nod < (int) matrice.size(); nod++) {
+        int bucle = 0;
+        for (int i = 1; i < (int) matrice[nod].size(); i++) {
+            int vecin = matrice[nod][i];
+            if (esteOrientat || nod < vecin) {
+                adaugareMuchie(nod, vecin);
+            } else if (nod == vecin && bucle++ % 2 == 0) { // o bucla apare de doua ori in lista nodului
+                adaugareMuchie(nod, vecin);
+            }
+        }
+    }
+}
+
+/*
+ * Construieste direct reprezentarea CSR dintr-o lista de muchii, in doua treceri liniare:
+ * se numara gradele nodurilor, se calculeaza sumele partiale, apoi fiecare muchie este pusa pe pozitia ei
+ * Pentru liste mari de muchii ambele treceri sunt impartite intre nrFire fire de executie, fiecare fir avand
+ * propriul vector de grade, astfel incat ordinea vecinilor este aceeasi ca la apeluri repetate de adaugareMuchie
+ * nrNoduri = numarul de noduri ale grafului
+ * muchii = perechile (x, y) ale muchiilor/arcelor
+ * esteOrientat = true -> graful este orientat; false -> graful este neorientat
+ * costuri = costul fiecarei muchii (sau gol daca graful nu are costuri)
+ * nrFire = numarul de fire de executie (0 -> numarul de nuclee)
+ * Graful rezultat este inghetat
+ */
+Graf::Graf(const int nrNoduri, const vector<pair<int, int>> &muchii, const bool esteOrientat,
+           const vector<int> &costuri, int nrFire) {
+    INSTR_FAZA("Graf::constructieDinMuchii");
+    this->nrNoduri = nrNoduri;
+    this->esteOrientat = esteOrientat;
+    this->areCosturi = !costuri.empty();
+    this->nrMuchii = (int) muchii.size();
+
+    long long nrMuchii = muchii.size();
+    long long nrIntrari = esteOrientat ? nrMuchii : 2 * nrMuchii;
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
+    }
+    // sub acest prag costul pornirii firelor depaseste castigul
+    if (nrMuchii < (1 << 16)) {
+        nrFire = 1;
+    }
+    // vectorii de grade ai firelor nu trebuie sa ocupe mai mult decat lista de muchii
+    nrFire = (int) max(1LL, min((long long) nrFire, nrIntrari / (nrNoduri + 2)));
+
+    // pozitie[fir][nod] = intai numarul de vecini ai lui nod gasiti de fir, apoi pozitia la care fir scrie urmatorul vecin
+    vector<vector<long long>> pozitie(nrFire, vector<long long>(nrNoduri + 2, 0));
+    auto bucata = [&](int fir, long long &inceput, long long &sfarsit) {
+        inceput = nrMuchii * fir / nrFire;
+        sfarsit = nrMuchii * (fir + 1) / nrFire;
+    };
+
+    // prima trecere: gradele
+    executieParalela(nrFire, [&](int fir) {
+        long long inceput, sfarsit;
+        bucata(fir, inceput, sfarsit);
+        vector<long long> &grad = pozitie[fir];
+        for (long long i = inceput; i < sfarsit; i++) {
+            grad[muchii[i].first]++;
+            if (!esteOrientat) {
+                grad[muchii[i].second]++;
+            }
+        }
+    });
+
+    // sumele partiale: offset-urile CSR si pozitia de start a fiecarui fir in lista fiecarui nod
+    inceputVecini.assign(nrNoduri + 2, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        long long curent = inceputVecini[nod];
+        for (int fir = 0; fir < nrFire; fir++) {
+            long long grad = pozitie[fir][nod];
+            pozitie[fir][nod] = curent;
+            curent += grad;
+        }
+        inceputVecini[nod + 1] = curent;
+    }
+
+    // a doua trecere: plasarea vecinilor
+    listaVecini.resize(nrIntrari);
+    listaIdMuchii.resize(nrIntrari);
+    if (areCosturi) {
+        listaCosturi.resize(nrIntrari);
+    }
+    executieParalela(nrFire, [&](int fir) {
+        long long inceput, sfarsit;
+        bucata(fir, inceput, sfarsit);
+        vector<long long> &urmator = pozitie[fir];
+        for (long long i = inceput; i < sfarsit; i++) {
+            int x = muchii[i].first, y = muchii[i].second;
+            long long k = urmator[x]++;
+            listaVecini[k] = y;
+            listaIdMuchii[k] = (int) i;
+            if (areCosturi) {
+                listaCosturi[k] = costuri[i];
+            }
+            if (!esteOrientat) {
+                k = urmator[y]++;
+                listaVecini[k] = x;
+                listaIdMuchii[k] = (int) i;
+                if (areCosturi) {
+                    listaCosturi[k] = costuri[i];
+                }
+            }
+        }
+    });
+
+    legareCSR();
+    esteInghetat = true;
+}
+
+/*
+ * Constructor de copiere care copiaza din obiectul primit ca parametru in obiectul curent
+ * graf = obiect de tipul Graf din care va fi copiat
+ */
+Graf::Graf(const Graf &graf) {
+    *this = graf;
+}
+
+/*
+ * Operator de atribuire: copiaza graful, iar pointerii CSR sunt refacuti catre vectorii proprii
+ * Daca graful este incarcat dintr-un fisier binar, maparea este partajata si nu se copiaza nimic
+ */
+Graf &Graf::operator=(const Graf &graf) {
+    if (this == &graf) {
+        return *this;
+    }
+    this->nrNoduri = graf.nrNoduri;
+    this->esteOrientat = graf.esteOrientat;
+    this->areCosturi = graf.areCosturi;
+    this->matriceAdiacenta.clear();
+    this->matriceAdiacenta = graf.matriceAdiacenta;
+    this->costuriAdiacenta = graf.costuriAdiacenta;
+    this->nrMuchii = graf.nrMuchii;
+    this->idMuchiiAdiacenta = graf.idMuchiiAdiacenta;
+    this->capeteMuchie = graf.capeteMuchie;
+    this->pozitieMuchie = graf.pozitieMuchie;
+    this->costMuchiiEliminate = graf.costMuchiiEliminate;
+    this->esteInghetat = graf.esteInghetat;
+    this->inceputVecini = graf.inceputVecini;
+    this->listaVecini = graf.listaVecini;
+    this->listaCosturi = graf.listaCosturi;
+    this->listaIdMuchii = graf.listaIdMuchii;
+    this->fisierMapat = graf.fisierMapat;
+    this->inceputTranspus = graf.inceputTranspus;
+    this->listaTranspus = graf.listaTranspus;
+    this->transpusConstruit.store(graf.transpusConstruit.load(memory_order_acquire), memory_order_relaxed);
+    this->puntiIncrementale = graf.puntiIncrementale;
+    this->urmarestePunti = graf.urmarestePunti;
+    this->puntiActuale = graf.puntiActuale;
+    this->ordineIncrementala = graf.ordineIncrementala;
+    this->urmaresteOrdinea = graf.urmaresteOrdinea;
+    this->ordineActuala = graf.ordineActuala;
+    this->grafCuCiclu = graf.grafCuCiclu;
+    if (this->fisierMapat) {
+        this->csrInceput = graf.csrInceput;
+        this->csrVecini = graf.csrVecini;
+        this->csrCosturi = graf.csrCosturi;
+        this->csrIdMuchii = graf.csrIdMuchii;
+    } else {
+        legareCSR();
+    }
+    return *this;
+}
+
+/*
+ * Citeste o pereche x,y si adauga in matricea de adiacenta muchiile/arcele citite
+ * in = stream-ul de intrare
+ * nrMuchii = numarul de muchii/arce citite
+ */
+void Graf::citireGraf(istream &in, const int nrMuchii) {
+    INSTR_FAZA("Graf::citireGraf");
+    int x, y;
+    for (int i = 0; i < nrMuchii; i++) {
+        in >> x >> y;
+        adaugareMuchie(x, y);
+    }
+}
+
+/*
+ * Varianta a citirii care foloseste cititorul rapid
+ * in = cititorul din care se citesc muchiile
+ * nrMuchii = numarul de muchii/arce citite
+ * Citirea se opreste la un fisier trunchiat (in.esteValid() devine false), fara muchii incomplete
+ */
+void Graf::citireGraf(CititorRapid &in, const int nrMuchii) {
+    INSTR_FAZA("Graf::citireGraf");
+    int x, y;
+    for (int i = 0; i < nrMuchii; i++) {
+        in >> x >> y;
+        if (!in.esteValid()) {
+            return;
+        }
+        adaugareMuchie(x, y);
+    }
+}
+
+/*
+ * Citeste triplete x,y,c si adauga in graf muchiile/arcele citite impreuna cu costurile lor
+ * in = cititorul din care se citesc muchiile
+ * nrMuchii = numarul de muchii/arce citite
+ * Ca la citireGraf, citirea se opreste la un fisier trunchiat
+ */
+void Graf::citireGrafCosturi(CititorRapid &in, const int nrMuchii) {
+    INSTR_FAZA("Graf::citireGrafCosturi");
+    int x, y, c;
+    for (int i = 0; i < nrMuchii; i++) {
+        in >> x >> y >> c;
+        if (!in.esteValid()) {
+            return;
+        }
+        adaugareMuchie(x, y, c);
+    }
+}
+
+/*
+ * Addauga o muchie in graf
+ * startNode = nodul din care porneste muchi
+ * endNode = nodul in care ajunge muchia
+ * In functie de tipul de graf, este actualizata matricea de adiacenta
+ * Returneaza id-ul muchiei adaugate, sau -1 daca arcul ar inchide un ciclu si ordinea topologica este urmarita
+ */
+int Graf::adaugareMuchie(const int startNode, const int endNode) {
+    if (!acceptareArc(startNode, endNode)) {
+        return -1;
+    }
+    dezghetare();
+    int id = muchieNoua(startNode, endNode);
+    adaugareInLista(startNode, endNode, id, 0, 0); // daca graful are costuri, muchia primeste costul 0
+    if (!this->esteOrientat) {
+        adaugareInLista(endNode, startNode, id, 1, 0);
+    }
+    actualizarePunti(startNode, endNode);
+    return id;
+}
+
+/*
+ * Adauga o muchie cu cost in graf
+ * startNode = nodul din care porneste muchia
+ * endNode = nodul in care ajunge muchia
+ * cost = costul muchiei
+ * La prima muchie cu cost, muchiile adaugate anterior primesc costul 0
+ * Returneaza id-ul muchiei adaugate, sau -1 daca arcul a fost refuzat (vezi adaugareMuchie fara cost)
+ */
+int Graf::adaugareMuchie(const int startNode, const int endNode, const int cost) {
+    if (!acceptareArc(startNode, endNode)) {
+        return -1;
+    }
+    dezghetare();
+    if (!this->areCosturi) {
+        this->costuriAdiacenta.assign(this->nrNoduri + 1, vector<int>());
+        for (int nod = 0; nod <= this->nrNoduri; nod++) {
+            this->costuriAdiacenta[nod].assign(this->matriceAdiacenta[nod].size(), 0);
+        }
+        this->areCosturi = true;
+    }
+
+    int id = muchieNoua(startNode, endNode);
+    adaugareInLista(startNode, endNode, id, 0, cost);
+    if (!this->esteOrientat) {
+        adaugareInLista(endNode, startNode, id, 1, cost);
+    }
+    actualizarePunti(startNode, endNode);
+    return id;
+}
+
+/*
+ * Rezerva un id pentru o muchie noua si ii retine capetele
+ */
+int Graf::muchieNoua(const int startNode, const int endNode) {
+    int id = this->nrMuchii++;
+    this->capeteMuchie.push_back(startNode);
+    this->capeteMuchie.push_back(endNode);
+    this->pozitieMuchie.push_back(0);
+    this->pozitieMuchie.push_back(0);
+    return id;
+}
+
+/*
+ * Adauga la finalul listei lui nod vecinul, id-ul si costul muchiei si retine pozitia la care a fost pusa
+ * capat = 0 daca nod este nodul de start al muchiei, 1 daca este nodul de final
+ */
+void Graf::adaugareInLista(const int nod, const int vecin, const int id, const int capat, const int cost) {
+    invalidareTranspus();
+    this->pozitieMuchie[2 * id + capat] = (int) this->matriceAdiacenta[nod].size();
+    this->matriceAdiacenta[nod].push_back(vecin);
+    this->idMuchiiAdiacenta[nod].push_back(id);
+    if (this->areCosturi) {
+        this->costuriAdiacenta[nod].push_back(cost);
+    }
+}
+
+/*
+ * Elimina prima muchie startNode-endNode gasita in lista lui startNode
+ * Cautarea muchiei costa O(grad(startNode)); doar eliminarea dupa id (eliminareMuchieId) este O(1)
+ */
+void Graf::eliminareMuchie(const int startNode, const int endNode) {
+    dezghetare();
+    for (int i = 1; i < (int) this->matriceAdiacenta[startNode].size(); i++) { // pozitia 0 este santinela
+        if (this->matriceAdiacenta[startNode][i] == endNode) {
+            eliminareMuchieId(this->idMuchiiAdiacenta[startNode][i]);
+            return;
+        }
+    }
+}
+
+/*
+ * Elimina muchia cu id-ul dat in O(1): in fiecare lista de adiacenta, locul ei este luat de ultima muchie din lista
+ * Muchia poate fi adaugata la loc cu reinserareMuchie
+ */
+void Graf::eliminareMuchieId(const int id) {
+    dezghetare();
+    if (this->pozitieMuchie[2 * id] == 0) { // muchia este deja eliminata
+        return;
+    }
+
+    int startNode = this->capeteMuchie[2 * id];
+    if (this->areCosturi) {
+        if (this->costMuchiiEliminate.size() < (size_t) this->nrMuchii) {
+            this->costMuchiiEliminate.resize(this->nrMuchii, 0);
+        }
+        this->costMuchiiEliminate[id] = this->costuriAdiacenta[startNode][this->pozitieMuchie[2 * id]];
+    }
+
+    eliminareDinLista(startNode, this->pozitieMuchie[2 * id]);
+    this->pozitieMuchie[2 * id] = 0;
+    this->puntiActuale = false; // eliminarile nu pot fi aplicate incremental
+    if (this->ordineActuala) {
+        if (this->grafCuCiclu) {
+            this->ordineActuala = false;
+        } else {
+            this->ordineIncrementala.eliminareArc(startNode, this->capeteMuchie[2 * id + 1]);
+        }
+    }
+    if (!this->esteOrientat) {
+        eliminareDinLista(this->capeteMuchie[2 * id + 1], this->pozitieMuchie[2 * id + 1]);
+        this->pozitieMuchie[2 * id + 1] = 0;
+    }
+}
+
+/*
+ * Adauga la loc, in O(1), o muchie eliminata cu eliminareMuchieId, cu acelasi id si acelasi cost
+ */
+void Graf::reinserareMuchie(const int id) {
+    dezghetare();
+    if (this->pozitieMuchie[2 * id] != 0) { // muchia nu este eliminata
+        return;
+    }
+
+    int startNode = this->capeteMuchie[2 * id], endNode = this->capeteMuchie[2 * id + 1];
+    if (startNode == 0) { // muchia a fost eliminata inainte ca graful sa fie salvat in fisierul binar
+        return;
+    }
+    if (!acceptareArc(startNode, endNode)) { // ar inchide un ciclu, deci ramane eliminata
+        return;
+    }
+    int cost = this->areCosturi && id < (int) this->costMuchiiEliminate.size() ? this->costMuchiiEliminate[id] : 0;
+    adaugareInLista(startNode, endNode, id, 0, cost);
+    if (!this->esteOrientat) {
+        adaugareInLista(endNode, startNode, id, 1, cost);
+    }
+    actualizarePunti(startNode, endNode);
+}
+
+/*
+ * Elimina elementul de pe pozitia data din lista lui nod (vecin, id si cost)
+ * Ultimul element din lista este mutat in locul celui eliminat, iar pozitia lui este actualizata
+ */
+void Graf::eliminareDinLista(const int nod, const int pozitie) {
+    invalidareTranspus();
+    int ultim = (int) this->matriceAdiacenta[nod].size() - 1;
+    if (pozitie != ultim) {
+        int idMutat = this->idMuchiiAdiacenta[nod][ultim];
+        this->matriceAdiacenta[nod][pozitie] = this->matriceAdiacenta[nod][ultim];
+        this->idMuchiiAdiacenta[nod][pozitie] = idMutat;
+        if (this->areCosturi) {
+            this->costuriAdiacenta[nod][pozitie] = this->costuriAdiacenta[nod][ultim];
+        }
+        // o bucla are ambele capete in lista lui nod, deci cautam capatul aflat pe pozitia ultim
+        int capat = (this->capeteMuchie[2 * idMutat] == nod && this->pozitieMuchie[2 * idMutat] == ultim) ? 0 : 1;
+        this->pozitieMuchie[2 * idMutat + capat] = pozitie;
+    }
+    this->matriceAdiacenta[nod].pop_back();
+    this->idMuchiiAdiacenta[nod].pop_back();
+    if (this->areCosturi) {
+        this->costuriAdiacenta[nod].pop_back();
+    }
+}
+
+/*
+ * Transforma matricea de adiacenta in reprezentarea CSR: un vector de offset-uri si un singur vector
+ * contiguu cu toti vecinii. Matricea de adiacenta este eliberata, parcurgerile folosind de acum CSR-ul.
+ * Complexitate O(n + m)
+ */
+void Graf::inghetare() {
+    if (esteInghetat) {
+        return;
+    }
+    INSTR_FAZA("Graf::inghetare");
+
+    inceputVecini.assign(nrNoduri + 2, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        inceputVecini[nod + 1] = inceputVecini[nod] + (long long) matriceAdiacenta[nod].size() - 1;
+    }
+
+    listaVecini.resize(inceputVecini[nrNoduri + 1]);
+    listaIdMuchii.resize(inceputVecini[nrNoduri + 1]);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        copy(matriceAdiacenta[nod].begin() + 1, matriceAdiacenta[nod].end(), listaVecini.begin() + inceputVecini[nod]);
+        copy(idMuchiiAdiacenta[nod].begin() + 1, idMuchiiAdiacenta[nod].end(),
+             listaIdMuchii.begin() + inceputVecini[nod]);
+    }
+    if (areCosturi) {
+        listaCosturi.resize(inceputVecini[nrNoduri + 1]);
+        for (int nod = 1; nod <= nrNoduri; nod++) {
+            copy(costuriAdiacenta[nod].begin() + 1, costuriAdiacenta[nod].end(),
+                 listaCosturi.begin() + inceputVecini[nod]);
+        }
+    }
+
+    // capeteMuchie raman, pentru ca muchiile eliminate sa poata fi adaugate la loc dupa dezghetare
+    vector<vector<int>>().swap(matriceAdiacenta);
+    vector<vector<int>>().swap(costuriAdiacenta);
+    vector<vector<int>>().swap(idMuchiiAdiacenta);
+    vector<int>().swap(pozitieMuchie);
+    legareCSR();
+    esteInghetat = true;
+}
+
+/*
+ * Reface matricea de adiacenta (cu santinela -1 pe prima pozitie) din reprezentarea CSR
+ * Este apelata automat de functiile care modifica graful
+ */
+void Graf::dezghetare() {
+    if (!esteInghetat) {
+        return;
+    }
+
+    matriceAdiacenta.assign(nrNoduri + 1, vector<int>(1, -1));
+    idMuchiiAdiacenta.assign(nrNoduri + 1, vector<int>(1, -1));
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        long long grad = sfarsitAdiacenta(nod) - inceputAdiacenta(nod);
+        matriceAdiacenta[nod].insert(matriceAdiacenta[nod].end(), inceputAdiacenta(nod), sfarsitAdiacenta(nod));
+        idMuchiiAdiacenta[nod].insert(idMuchiiAdiacenta[nod].end(), inceputIdMuchii(nod), inceputIdMuchii(nod) + grad);
+    }
+    if (areCosturi) {
+        costuriAdiacenta.assign(nrNoduri + 1, vector<int>(1, 0));
+        for (int nod = 1; nod <= nrNoduri; nod++) {
+            costuriAdiacenta[nod].insert(costuriAdiacenta[nod].end(), inceputCosturi(nod),
+                                         inceputCosturi(nod) + (sfarsitAdiacenta(nod) - inceputAdiacenta(nod)));
+        }
+    }
+
+    // refacem pozitiile muchiilor; daca graful a fost construit direct in CSR, refacem si capetele lor: nodul de start
+    // devine nodul in a carui lista apare prima data muchia. Intr-un graf orientat acesta este chiar nodul de start
+    // (arcul apare doar in lista lui), dar intr-un graf neorientat este cel mai mic dintre capete, nu neaparat
+    // primul capat dat la constructie (orientarea nu este pastrata in CSR)
+    bool refacereCapete = capeteMuchie.size() != 2 * (size_t) nrMuchii;
+    if (refacereCapete) {
+        capeteMuchie.assign(2 * (size_t) nrMuchii, 0);
+    }
+    pozitieMuchie.assign(2 * (size_t) nrMuchii, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        for (int i = 1; i < (int) idMuchiiAdiacenta[nod].size(); i++) {
+            int id = idMuchiiAdiacenta[nod][i];
+            if (refacereCapete && capeteMuchie[2 * id] == 0) {
+                capeteMuchie[2 * id] = nod;
+                capeteMuchie[2 * id + 1] = matriceAdiacenta[nod][i];
+            }
+            int capat = (capeteMuchie[2 * id] == nod && pozitieMuchie[2 * id] == 0) ? 0 : 1;
+            pozitieMuchie[2 * id + capat] = i;
+        }
+    }
+
+    eliberareCSR();
+}
+
+/*
+ * Pointerii CSR indica in vectorii inceputVecini si listaVecini ai grafului
+ */
+void Graf::legareCSR() {
+    csrInceput = inceputVecini.data();
+    csrVecini = listaVecini.data();
+    csrCosturi = listaCosturi.data();
+    csrIdMuchii = listaIdMuchii.data();
+}
+
+/*
+ * Elibereaza reprezentarea CSR (vectorii proprii sau fisierul mapat)
+ */
+void Graf::eliberareCSR() {
+    vector<long long>().swap(inceputVecini);
+    vector<int>().swap(listaVecini);
+    vector<int>().swap(listaCosturi);
+    vector<int>().swap(listaIdMuchii);
+    fisierMapat.reset();
+    csrInceput = nullptr;
+    csrVecini = nullptr;
+    csrCosturi = nullptr;
+    csrIdMuchii = nullptr;
+    esteInghetat = false;
+    invalidareTranspus();
+}
+
+/*
+ * Construieste transpusul unui graf orientat (daca nu exista deja), numarand intai gradele interioare
+ * In lista fiecarui nod, predecesorii apar in ordine crescatoare
+ * Daca mai multe fire il cer in acelasi timp, doar primul il construieste, iar celelalte asteapta la mutex
+ * Complexitate O(n + m)
+ */
+void Graf::constructieTranspus() {
+    if (!esteOrientat || transpusConstruit.load(memory_order_acquire)) {
+        return;
+    }
+    lock_guard<mutex> garda(mutexTranspus);
+    if (transpusConstruit.load(memory_order_relaxed)) {
+        return;
+    }
+    INSTR_FAZA("Graf::constructieTranspus");
+    inceputTranspus.assign(nrNoduri + 2, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+            inceputTranspus[*it + 1]++;
+        }
+    }
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        inceputTranspus[nod + 1] += inceputTranspus[nod];
+    }
+
+    listaTranspus.resize(inceputTranspus[nrNoduri + 1]);
+    vector<long long> urmator(inceputTranspus.begin(), inceputTranspus.end() - 1);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+            listaTranspus[urmator[*it]++] = nod;
+        }
+    }
+    transpusConstruit.store(true, memory_order_release);
+}
+
+/*
+ * Antetul fisierului binar in care este salvat un graf. Dupa antet urmeaza:
+ *   long long inceputVecini[nrNoduri + 2]
+ *   int listaVecini[nrIntrari]
+ *   int listaIdMuchii[nrIntrari]
+ *   int listaCosturi[nrIntrari] (doar daca optiuni contine OPTIUNE_COSTURI)
+ * Numerele sunt scrise in formatul nativ al masinii (fisierul nu este portabil intre arhitecturi diferite)
+ * Fisierele salvate cu o alta versiune nu sunt acceptate si trebuie regenerate
+ */
+struct AntetGrafBinar {
+    char semnatura[8]; // "GRAFCSR"
+    uint32_t versiune;
+    uint32_t optiuni; // combinatie de OPTIUNE_ORIENTAT si OPTIUNE_COSTURI
+    int64_t nrNoduri;
+    int64_t nrIntrari; // numarul de elemente din listaVecini
+    int64_t nrMuchii; // numarul de id-uri de muchii folosite
+};
+
+const char SEMNATURA_GRAF_BINAR[8] = "GRAFCSR";
+const uint32_t VERSIUNE_GRAF_BINAR = 3;
+const uint32_t OPTIUNE_ORIENTAT = 1, OPTIUNE_COSTURI = 2;
+
+/*
+ * Salveaza graful intr-un fisier binar care poate fi incarcat ulterior cu incarcareBinar
+ * Graful este inghetat inainte de salvare; muchiile eliminate nu sunt salvate si nu mai pot fi adaugate la loc
+ * Returneaza true daca salvarea a reusit
+ */
+bool Graf::salvareBinar(const char *numeFisier) {
+    INSTR_FAZA("Graf::salvareBinar");
+    inghetare();
+
+    // scriem intr-un fisier temporar pe care il redenumim la final, astfel incat un graf mapat
+    // din numeFisier (chiar si acesta) sa ramana valid
+    string numeTemporar = string(numeFisier) + ".tmp";
+    FILE *fisier = fopen(numeTemporar.c_str(), "wb");
+    if (fisier == nullptr) {
+        return false;
+    }
+
+    AntetGrafBinar antet;
+    memcpy(antet.semnatura, SEMNATURA_GRAF_BINAR, sizeof(antet.semnatura));
+    antet.versiune = VERSIUNE_GRAF_BINAR;
+    antet.optiuni = (esteOrientat ? OPTIUNE_ORIENTAT : 0) | (areCosturi ? OPTIUNE_COSTURI : 0);
+    antet.nrNoduri = nrNoduri;
+    antet.nrIntrari = csrInceput[nrNoduri + 1];
+    antet.nrMuchii = nrMuchii;
+
+    bool ok = fwrite(&antet, sizeof(antet), 1, fisier) == 1;
+    ok = ok && fwrite(csrInceput, sizeof(long long), nrNoduri + 2, fisier) == (size_t) nrNoduri + 2;
+    if (antet.nrIntrari > 0) {
+        ok = ok && fwrite(csrVecini, sizeof(int), antet.nrIntrari, fisier) == (size_t) antet.nrIntrari;
+        ok = ok && fwrite(csrIdMuchii, sizeof(int), antet.nrIntrari, fisier) == (size_t) antet.nrIntrari;
+        if (areCosturi) {
+            ok = ok && fwrite(csrCosturi, sizeof(int), antet.nrIntrari, fisier) == (size_t) antet.nrIntrari;
+        }
+    }
+    ok = fclose(fisier) == 0 && ok;
+    if (!ok || rename(numeTemporar.c_str(), numeFisier) != 0) {
+        remove(numeTemporar.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Incarca un graf salvat cu salvareBinar. Fisierul este mapat in memorie, iar graful inghetat
+ * foloseste direct datele din fisier, fara nicio copiere
+ * Inainte de a fi folosit, fisierul este verificat intr-o singura trecere: offset-urile pornesc de la 0, nu scad si
+ * se termina la nrIntrari, vecinii sunt in 1..nrNoduri, iar id-urile muchiilor in 0..nrMuchii - 1
+ * Returneaza false daca fisierul lipseste sau nu este valid (inclusiv trunchiat), caz in care graful nu este modificat
+ */
+bool Graf::incarcareBinar(const char *numeFisier) {
+    INSTR_FAZA("Graf::incarcareBinar");
+    shared_ptr<CititorRapid> fisier = make_shared<CititorRapid>(numeFisier, false);
+    if (!fisier->esteDeschis() || fisier->dimensiune() < sizeof(AntetGrafBinar)) {
+        return false;
+    }
+
+    AntetGrafBinar antet;
+    memcpy(&antet, fisier->dateBrute(), sizeof(antet));
+    if (memcmp(antet.semnatura, SEMNATURA_GRAF_BINAR, sizeof(antet.semnatura)) != 0 ||
+        antet.versiune != VERSIUNE_GRAF_BINAR || antet.nrNoduri < 0 || antet.nrIntrari < 0 || antet.nrMuchii < 0 ||
+        antet.nrNoduri >= INT_MAX || antet.nrMuchii > INT_MAX ||
+        (size_t) antet.nrNoduri > fisier->dimensiune() || (size_t) antet.nrIntrari > fisier->dimensiune()) {
+        return false;
+    }
+    bool cuCosturi = (antet.optiuni & OPTIUNE_COSTURI) != 0;
+    size_t dimensiuneAsteptata = sizeof(antet) + (antet.nrNoduri + 2) * sizeof(long long) +
+                                 antet.nrIntrari * sizeof(int) * (cuCosturi ? 3 : 2);
+    if (fisier->dimensiune() != dimensiuneAsteptata) {
+        return false;
+    }
+
+    const long long *inceput = (const long long *) (fisier->dateBrute() + sizeof(antet));
+    const int *vecini = (const int *) (inceput + antet.nrNoduri + 2), *idMuchii = vecini + antet.nrIntrari;
+    if (inceput[0] != 0 || inceput[antet.nrNoduri + 1] != antet.nrIntrari) {
+        return false;
+    }
+    for (long long nod = 0; nod <= antet.nrNoduri; nod++) {
+        if (inceput[nod + 1] < inceput[nod]) {
+            return false;
+        }
+    }
+    for (long long i = 0; i < antet.nrIntrari; i++) {
+        if (vecini[i] < 1 || vecini[i] > antet.nrNoduri || idMuchii[i] < 0 || idMuchii[i] >= antet.nrMuchii) {
+            return false;
+        }
+    }
+
+    eliberareCSR();
+    vector<vector<int>>().swap(matriceAdiacenta);
+    nrNoduri = (int) antet.nrNoduri;
+    puntiActuale = false;
+    ordineActuala = false;
+    esteOrientat = (antet.optiuni & OPTIUNE_ORIENTAT) != 0;
+    areCosturi = cuCosturi;
+    nrMuchii = (int) antet.nrMuchii;
+    vector<vector<int>>().swap(costuriAdiacenta);
+    vector<vector<int>>().swap(idMuchiiAdiacenta);
+    capeteMuchie.clear();
+    pozitieMuchie.clear();
+    costMuchiiEliminate.clear();
+    fisierMapat = fisier;
+    csrInceput = inceput;
+    csrVecini = vecini;
+    csrIdMuchii = idMuchii;
+    csrCosturi = areCosturi ? csrIdMuchii + antet.nrIntrari : nullptr;
+    esteInghetat = true;
+    return true;
+}
+
+/*
+ * BFS din start care retine pentru fiecare nod parintele (in vizitate, -1 pentru start) si id-ul muchiei
+ * prin care a fost descoperit (in muchii)
+ */
+void Graf::bfs_marmelada(int start, vector<int> &vizitate, vector<int> &muchii) {
+    INSTR_FAZA("Graf::bfs_marmelada");
+
+    // Queue in care salvam elementele care trebuiesc vizitate. Cand se goleste, nu mai avem nimic de vizitat
+    queue<int> queue;
+    queue.push(start);
+    vizitate[start] = -1;
+
+    while (!queue.empty()) {
+        int nodUrm = queue.front();
+        queue.pop();
+        const int *vecini = inceputAdiacenta(nodUrm), *idMuchii = inceputIdMuchii(nodUrm);
+        long long nrVecini = sfarsitAdiacenta(nodUrm) - vecini;
+        INSTR_CONTOR(NODURI_VIZITATE, 1);
+        INSTR_CONTOR(MUCHII_SCANATE, nrVecini);
+        for (long long i = 0; i < nrVecini; i++) { // parcurgem fiecare nod adiacent al nodului curent
+            int nod = vecini[i];
+            int muchie = idMuchii[i];
+            // Daca nu a fost vizitat inca
+            if (!vizitate[nod]) {
+                vizitate[nod] = nodUrm;
+                muchii[nod] = muchie;
+                queue.push(nod); // Il adaugam in coada pentru a fi vizitat
+            }
+        }
+    }
+}
+
+
+/*
+ * Varianta pastrata pentru compatibilitate; stream-ul nu este folosit, afisarea fiind facuta de apelant
+ */
+vector<int> Graf::distantaMinimaBFS(ostream &out, const int start) {
+    return distantaMinimaBFS(start);
+}
+
+/*
+ * Calculeaza distanta minima de la fiecare nod la start
+ * start = nodul de start
+ */
+vector<int> Graf::distantaMinimaBFS(int start) {
+    INSTR_FAZA("Graf::distantaMinimaBFS");
+    // Vector pentru distanta in care fiecare element este initial -1
+    vector<int> distanta(nrNoduri + 1, -1);
+    distanta[start] = 0;
+
+    // Queue in care salvam elementele care trebuiesc vizitate. Cand se goleste, nu mai avem nimic de vizitat
+    queue<int> queue;
+    queue.push(start);
+
+    while (!queue.empty()) {
+        start = queue.front();
+        queue.pop();
+        INSTR_CONTOR(NODURI_VIZITATE, 1);
+        INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(start) - inceputAdiacenta(start));
+        for (const int *it = inceputAdiacenta(start); it != sfarsitAdiacenta(start); it++) { // parcurgem fiecare nod adiacent al nodului curent
+            // Daca nu a fost vizitat inca
+            if (distanta[*it] == -1) {
+                distanta[*it] = distanta[start] + 1;
+                queue.push(*it); // Il adaugam in coada pentru a fi vizitat
+            }
+        }
+    }
+
+    // Returnam distanta
+    return distanta;
+
+}
+
+/*
+ * BFS pornit simultan din toate sursele (ca in problema muzeu, unde toti paznicii sunt pusi initial in coada)
+ * surse = nodurile de start
+ * sursaApropiata = la final, sursaApropiata[nod] = sursa care a ajuns prima la nod (-1 daca nod nu este accesibil)
+ * La distante egale castiga sursa care apare prima in surse, deci rezultatul este determinist
+ * Returneaza distanta de la fiecare nod la cea mai apropiata sursa (-1 daca nu este accesibil), intr-o singura
+ * parcurgere O(n + m), in loc de cate un BFS pentru fiecare sursa
+ */
+vector<int> Graf::distantaMinimaBFSMultiSursa(const vector<int> &surse, vector<int> &sursaApropiata) {
+    INSTR_FAZA("Graf::distantaMinimaBFSMultiSursa");
+    vector<int> distanta(nrNoduri + 1, -1);
+    sursaApropiata.assign(nrNoduri + 1, -1);
+
+    vector<int> coada;
+    coada.reserve(nrNoduri);
+    for (int sursa: surse) {
+        if (distanta[sursa] == -1) {
+            distanta[sursa] = 0;
+            sursaApropiata[sursa] = sursa;
+            coada.push_back(sursa);
+        }
+    }
+
+    for (size_t i = 0; i < coada.size(); i++) {
+        int nod = coada[i];
+        INSTR_CONTOR(NODURI_VIZITATE, 1);
+        INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(nod) - inceputAdiacenta(nod));
+        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+            if (distanta[*it] == -1) {
+                distanta[*it] = distanta[nod] + 1;
+                sursaApropiata[*it] = sursaApropiata[nod];
+                coada.push_back(*it);
+            }
+        }
+    }
+    return distanta;
+}
+
+/*
+ * Drum minim (ca numar de muchii) intre start si final, cautat bidirectional: o parcurgere porneste din start
+ * pe muchiile grafului, cealalta din final pe muchiile inversate (transpusul, pentru un graf orientat).
+ * La fiecare pas este extins un nivel complet al frontierei cu mai putine muchii; cand un nod este atins de ambele
+ * parcurgeri, nivelul curent este terminat (un drum mai scurt poate trece printr-un alt nod al aceluiasi nivel)
+ * si cautarea se opreste. Pe grafuri mari si rare sunt vizitate de obicei foarte putine noduri.
+ * Returneaza nodurile drumului, de la start la final (distanta = numarul lor - 1), sau un vector gol daca final
+ * nu este accesibil din start
+ */
+vector<int> Graf::drumMinimBFS(const int start, const int final) {
+    INSTR_FAZA("Graf::drumMinimBFS");
+    if (start == final) {
+        return vector<int>(1, start);
+    }
+    constructieTranspus();
+
+    // spatiul 0 pentru parcurgerea din start, spatiul 1 pentru cea din final; in fiecare, valoare = distanta,
+    // parinte = parintele (respectiv succesorul pe drumul catre final), lista = frontiera curenta
+    SpatiuLucru *spatiu[2] = {&SpatiuLucru::alFirului(0), &SpatiuLucru::alFirului(1)};
+    vector<int> urmatoare;
+    spatiu[0]->pregatire(nrNoduri);
+    spatiu[1]->pregatire(nrNoduri);
+    spatiu[0]->vizitare(start);
+    spatiu[0]->valoare[start] = 0;
+    spatiu[0]->lista.push_back(start);
+    spatiu[1]->vizitare(final);
+    spatiu[1]->valoare[final] = 0;
+    spatiu[1]->lista.push_back(final);
+    long long muchiiFrontiera[2] = {sfarsitAdiacenta(start) - inceputAdiacenta(start),
+                                    sfarsitIntrari(final) - inceputIntrari(final)};
+
+    int lungimeMinima = INT_MAX, nodIntalnire = 0;
+    while (!spatiu[0]->lista.empty() && !spatiu[1]->lista.empty() && nodIntalnire == 0) {
+        int sens = muchiiFrontiera[0] <= muchiiFrontiera[1] ? 0 : 1;
+        SpatiuLucru &curent = *spatiu[sens], &opus = *spatiu[1 - sens];
+        urmatoare.clear();
+        muchiiFrontiera[sens] = 0;
+        for (int nod: curent.lista) {
+            const int *inceput = sens == 0 ? inceputAdiacenta(nod) : inceputIntrari(nod);
+            const int *sfarsit = sens == 0 ? sfarsitAdiacenta(nod) : sfarsitIntrari(nod);
+            INSTR_CONTOR(NODURI_VIZITATE, 1);
+            INSTR_CONTOR(MUCHII_SCANATE, sfarsit - inceput);
+            for (const int *it = inceput; it != sfarsit; it++) {
+                if (!curent.vizitat(*it)) {
+                    curent.vizitare(*it);
+                    curent.valoare[*it] = curent.valoare[nod] + 1;
+                    curent.parinte[*it] = nod;
+                    urmatoare.push_back(*it);
+                    muchiiFrontiera[sens] += sens == 0 ? sfarsitAdiacenta(*it) - inceputAdiacenta(*it)
+                                                       : sfarsitIntrari(*it) - inceputIntrari(*it);
+                }
+                if (opus.vizitat(*it) && curent.valoare[*it] + opus.valoare[*it] < lungimeMinima) {
+                    lungimeMinima = curent.valoare[*it] + opus.valoare[*it];
+                    nodIntalnire = *it;
+                }
+            }
+        }
+        curent.lista.swap(urmatoare);
+    }
+
+    vector<int> drum;
+    if (nodIntalnire == 0) {
+        return drum;
+    }
+    for (int nod = nodIntalnire; nod != start; nod = spatiu[0]->parinte[nod]) {
+        drum.push_back(nod);
+    }
+    drum.push_back(start);
+    reverse(drum.begin(), drum.end());
+    for (int nod = nodIntalnire; nod != final; ) {
+        nod = spatiu[1]->parinte[nod];
+        drum.push_back(nod);
+    }
+    return drum;
+}
+
+/*
+ * Pana la 64 de parcurgeri BFS simultane: fiecare nod are o masca pe 64 de biti, bitul i fiind setat
+ * daca nodul a fost atins de parcurgerea din surse[i]. La fiecare nivel, masca nodurilor din frontiera este
+ * propagata catre vecini cu un singur OR, deci o trecere prin listele de adiacenta avanseaza toate cautarile o data.
+ * Frontiera este tinuta si ca lista de noduri: cand este mica, un nivel costa doar cat nodurile si muchiile atinse,
+ * iar cand cuprinde peste 1/16 din noduri este parcursa secvential, in ordinea nodurilor
+ * peNivel(nivel, noduri, noi) este apelata dupa fiecare nivel: noduri = nodurile atinse de cel putin o sursa
+ * exact la acel nivel, iar noi[nod] = bitii acelor surse (nivelul 0 contine sursele)
+ * Un nod intra in frontiera de cel mult 64 de ori, deci complexitatea este O(64 (n + m)) in cel mai rau caz
+ */
+void Graf::BFSBitParalel(const int *surse, const int nrSurse,
+                         const function<void(int nivel, const vector<int> &noduri,
+                                             const vector<unsigned long long> &noi)> &peNivel) {
+    vector<unsigned long long> vazute(nrNoduri + 1, 0), frontiera(nrNoduri + 1, 0), urmatoare(nrNoduri + 1, 0);
+    vector<int> noduriFrontiera, noduriAtinse;
+    for (int i = 0; i < nrSurse; i++) {
+        if (frontiera[surse[i]] == 0) {
+            noduriFrontiera.push_back(surse[i]);
+        }
+        frontiera[surse[i]] |= 1ULL << i;
+        vazute[surse[i]] |= 1ULL << i;
+    }
+
+    for (int nivel = 0; !noduriFrontiera.empty(); nivel++) {
+        peNivel(nivel, noduriFrontiera, frontiera);
+
+        if (noduriFrontiera.size() * 16 > (size_t) nrNoduri) {
+            // frontiera densa: nodurile sunt parcurse in ordine, ca accesele la liste si la masti sa fie secventiale
+            for (int nod = 1; nod <= nrNoduri; nod++) {
+                unsigned long long masca = frontiera[nod];
+                if (masca == 0) {
+                    continue;
+                }
+                frontiera[nod] = 0;
+                INSTR_CONTOR(NODURI_VIZITATE, 1);
+                INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(nod) - inceputAdiacenta(nod));
+                for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                    urmatoare[*it] |= masca;
+                }
+            }
+            noduriFrontiera.clear();
+            for (int nod = 1; nod <= nrNoduri; nod++) {
+                unsigned long long noi = urmatoare[nod] & ~vazute[nod];
+                urmatoare[nod] = 0;
+                if (noi != 0) {
+                    vazute[nod] |= noi;
+                    frontiera[nod] = noi;
+                    noduriFrontiera.push_back(nod);
+                }
+            }
+            continue;
+        }
+
+        // frontiera rara: sunt atinse doar nodurile din lista si vecinii lor
+        noduriAtinse.clear();
+        for (int nod: noduriFrontiera) {
+            unsigned long long masca = frontiera[nod];
+            frontiera[nod] = 0;
+            INSTR_CONTOR(NODURI_VIZITATE, 1);
+            INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(nod) - inceputAdiacenta(nod));
+            for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                if (urmatoare[*it] == 0) {
+                    noduriAtinse.push_back(*it);
+                }
+                urmatoare[*it] |= masca;
+            }
+        }
+
+        noduriFrontiera.clear();
+        for (int nod: noduriAtinse) {
+            unsigned long long noi = urmatoare[nod] & ~vazute[nod];
+            urmatoare[nod] = 0;
+            if (noi != 0) {
+                vazute[nod] |= noi;
+                frontiera[nod] = noi;
+                noduriFrontiera.push_back(nod);
+            }
+        }
+    }
+}
+
+/*
+ * Distantele de la fiecare sursa (cel mult 64) la toate nodurile, calculate cu BFSBitParalel
+ * Returneaza result[i][nod] = distanta de la surse[i] la nod (-1 daca nod nu este accesibil)
+ */
+vector<vector<int>> Graf::distanteBitParalel(const vector<int> &surse) {
+    INSTR_FAZA("Graf::distanteBitParalel");
+    int nrSurse = (int) min(surse.size(), (size_t) 64);
+    vector<vector<int>> result(nrSurse, vector<int>(nrNoduri + 1, -1));
+    BFSBitParalel(surse.data(), nrSurse, [&](int nivel, const vector<int> &noduri,
+                                             const vector<unsigned long long> &noi) {
+        for (int nod: noduri) {
+            for (unsigned long long masca = noi[nod]; masca != 0; masca &= masca - 1) {
+                result[__builtin_ctzll(masca)][nod] = nivel;
+            }
+        }
+    });
+    return result;
+}
+
+/*
+ * Excentricitatea fiecarui nod: distanta maxima de la el la un nod accesibil din el
+ * Nodurile sunt luate in loturi de cate 64, fiecare lot fiind o singura parcurgere BFSBitParalel:
+ * excentricitatea sursei i este ultimul nivel la care bitul i mai apare in vreun nod
+ * Loturile sunt independente si sunt impartite intre nrFire fire de executie (0 -> numarul de nuclee)
+ * Returneaza result[nod] = excentricitatea lui nod
+ */
+vector<int> Graf::excentricitati(int nrFire) {
+    INSTR_FAZA("Graf::excentricitati");
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
+    }
+    int nrLoturi = (nrNoduri + 63) / 64;
+    nrFire = max(1, min(nrFire, nrLoturi));
+
+    vector<int> result(nrNoduri + 1, 0);
+    atomic<int> urmatorulLot(0);
+    executieParalela(nrFire, [&](int) {
+        for (int lot = urmatorulLot.fetch_add(1); lot < nrLoturi; lot = urmatorulLot.fetch_add(1)) {
+            int surse[64], nrSurse = 0;
+            for (int nod = lot * 64 + 1; nod <= min(nrNoduri, lot * 64 + 64); nod++) {
+                surse[nrSurse++] = nod;
+            }
+            BFSBitParalel(surse, nrSurse, [&](int nivel, const vector<int> &noduri,
+                                              const vector<unsigned long long> &noi) {
+                unsigned long long atinse = 0;
+                for (int nod: noduri) {
+                    atinse |= noi[nod];
+                }
+                for (; atinse != 0; atinse &= atinse - 1) {
+                    result[surse[__builtin_ctzll(atinse)]] = nivel;
+                }
+            });
+        }
+    });
+    return result;
+}
+
+/*
+ * BFS cu optimizarea directiei (Beamer): nivelurile mici sunt explorate "de sus in jos" (din frontiera catre vecini),
+ * iar cand frontiera este in crestere si ajunge sa aiba mai multe muchii decat o fractiune (1/alfa) din muchiile
+ * nodurilor neexplorate, explorarea trece "de jos in sus": fiecare nod nevizitat isi cauta un predecesor in frontiera (memorata ca bitmap)
+ * si se opreste la primul gasit. Cand frontiera scade sub nrNoduri / beta noduri, se revine la varianta de sus in jos.
+ * Pe grafurile cu diametru mic (retele sociale, R-MAT) majoritatea muchiilor nu mai sunt inspectate deloc.
+ * Returneaza acelasi vector de distante ca distantaMinimaBFS
+ * Pentru un graf orientat foloseste transpusul, construit la primul apel
+ */
+vector<int> Graf::distantaMinimaBFSHibrid(int start) {
+    INSTR_FAZA("Graf::distantaMinimaBFSHibrid");
+    const long long alfa = 14, beta = 24;
+    constructieTranspus();
+
+    vector<int> distanta(nrNoduri + 1, -1);
+    distanta[start] = 0;
+
+    // de sus in jos, frontiera este intervalul [inceput, sfarsit) al cozii, iar nivelul urmator se adauga la final
+    vector<int> coada(nrNoduri + 1);
+    size_t inceput = 0, sfarsit = 1;
+    coada[0] = start;
+    size_t nrCuvinte = nrNoduri / 64 + 1;
+    vector<unsigned long long> bitiFrontiera, bitiUrmatoare;
+
+    // muchiiFrontiera = suma gradelor nodurilor din frontiera, muchiiNeexplorate = suma gradelor nodurilor nevizitate
+    long long muchiiNeexplorate = 0, muchiiFrontiera = sfarsitAdiacenta(start) - inceputAdiacenta(start);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        muchiiNeexplorate += sfarsitAdiacenta(nod) - inceputAdiacenta(nod);
+    }
+    muchiiNeexplorate -= muchiiFrontiera;
+
+    long long nrFrontiera = 1, nrFrontieraAnterioara = 0;
+    bool deJosInSus = false;
+    for (int nivel = 1; nrFrontiera > 0; nivel++) {
+        // conditia de crestere evita comutarile repetate la coada parcurgerii, cand au ramas putine muchii neexplorate
+        bool inCrestere = nrFrontiera > nrFrontieraAnterioara;
+        nrFrontieraAnterioara = nrFrontiera;
+        if (!deJosInSus && inCrestere && muchiiFrontiera > muchiiNeexplorate / alfa) {
+            // trecem frontiera din lista in bitmap
+            bitiFrontiera.assign(nrCuvinte, 0);
+            bitiUrmatoare.assign(nrCuvinte, 0);
+            for (size_t i = inceput; i < sfarsit; i++) {
+                bitiFrontiera[coada[i] >> 6] |= 1ULL << (coada[i] & 63);
+            }
+            deJosInSus = true;
+        } else if (deJosInSus && !inCrestere && nrFrontiera < nrNoduri / beta) {
+            // trecem frontiera din bitmap in lista
+            inceput = sfarsit = 0;
+            for (int nod = 1; nod <= nrNoduri; nod++) {
+                if (distanta[nod] == nivel - 1) {
+                    coada[sfarsit++] = nod;
+                }
+            }
+            deJosInSus = false;
+        }
+
+        nrFrontiera = 0;
+        muchiiFrontiera = 0;
+        if (!deJosInSus) {
+            size_t sfarsitNivel = sfarsit;
+            for (; inceput < sfarsitNivel; inceput++) {
+                int nod = coada[inceput];
+                INSTR_CONTOR(NODURI_VIZITATE, 1);
+                INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(nod) - inceputAdiacenta(nod));
+                for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                    if (distanta[*it] == -1) {
+                        distanta[*it] = nivel;
+                        coada[sfarsit++] = *it;
+                        muchiiFrontiera += sfarsitAdiacenta(*it) - inceputAdiacenta(*it);
+                    }
+                }
+            }
+            nrFrontiera = (long long) (sfarsit - inceput);
+        } else {
+            fill(bitiUrmatoare.begin(), bitiUrmatoare.end(), 0);
+            for (int nod = 1; nod <= nrNoduri; nod++) {
+                if (distanta[nod] != -1) {
+                    continue;
+                }
+                for (const int *it = inceputIntrari(nod); it != sfarsitIntrari(nod); it++) {
+                    INSTR_CONTOR(MUCHII_SCANATE, 1);
+                    if (bitiFrontiera[*it >> 6] >> (*it & 63) & 1) {
+                        INSTR_CONTOR(NODURI_VIZITATE, 1);
+                        distanta[nod] = nivel;
+                        bitiUrmatoare[nod >> 6] |= 1ULL << (nod & 63);
+                        nrFrontiera++;
+                        muchiiFrontiera += sfarsitAdiacenta(nod) - inceputAdiacenta(nod);
+                        break;
+                    }
+                }
+            }
+            bitiFrontiera.swap(bitiUrmatoare);
+        }
+        muchiiNeexplorate -= muchiiFrontiera;
+    }
+
+    return distanta;
+}
+
+/*
+ * BFS paralel, sincronizat pe niveluri: frontiera nivelului curent este impartita in blocuri pe care firele
+ * le iau pe rand (cu un contor atomic). Un nod nevizitat este revendicat printr-un compare-and-swap pe distanta lui,
+ * deci fiecare nod intra in frontiera o singura data. Fiecare fir strange nodurile revendicate intr-un buffer propriu,
+ * iar la finalul nivelului bufferele sunt copiate unul dupa altul in coada, la pozitii calculate din dimensiunile lor.
+ * Returneaza acelasi vector de distante ca distantaMinimaBFS
+ * nrFire = numarul de fire de executie (0 -> numarul de nuclee)
+ * Fiecare nivel costa doua bariere, asa ca pe grafuri cu diametru foarte mare (drumuri) varianta secventiala ramane
+ * mai rapida
+ */
+vector<int> Graf::distantaMinimaBFSParalel(int start, int nrFire) {
+    INSTR_FAZA("Graf::distantaMinimaBFSParalel");
+    const long long marimeBloc = 64;
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
+    }
+
+    vector<atomic<int>> distantaAtomica(nrNoduri + 1);
+    for (int nod = 0; nod <= nrNoduri; nod++) {
+        distantaAtomica[nod].store(-1, memory_order_relaxed);
+    }
+    distantaAtomica[start].store(0, memory_order_relaxed);
+
+    // frontiera nivelului curent este intervalul [inceput, sfarsit) al cozii; fiecare fir isi tine propria copie
+    // a capetelor, identica la toate firele, pentru ca este calculata din aceleasi dimensiuni ale bufferelor
+    vector<int> coada(nrNoduri + 1);
+    coada[0] = start;
+    atomic<long long> urmatorulBloc(0);
+    vector<vector<int>> buffere(nrFire);
+    BarieraFire bariera(nrFire);
+
+    executieParalela(nrFire, [&](int fir) {
+        vector<int> &buffer = buffere[fir];
+        long long inceput = 0, sfarsit = 1;
+        for (int nivel = 1; inceput < sfarsit; nivel++) {
+            for (long long bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed);
+                 bloc < sfarsit; bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed)) {
+                long long sfarsitBloc = min(bloc + marimeBloc, sfarsit);
+                for (long long i = bloc; i < sfarsitBloc; i++) {
+                    int nod = coada[i];
+                    INSTR_CONTOR(NODURI_VIZITATE, 1);
+                    INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(nod) - inceputAdiacenta(nod));
+                    for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                        int nevizitat = -1;
+                        if (distantaAtomica[*it].load(memory_order_relaxed) == -1 &&
+                            distantaAtomica[*it].compare_exchange_strong(nevizitat, nivel, memory_order_relaxed)) {
+                            buffer.push_back(*it);
+                        }
+                    }
+                }
+            }
+            bariera.asteptare();
+
+            // nivelul urmator: bufferele firelor 0, 1, ..., nrFire - 1, in aceasta ordine, incepand de la sfarsit
+            long long pozitie = sfarsit, sfarsitUrmator = sfarsit;
+            for (int i = 0; i < nrFire; i++) {
+                if (i < fir) {
+                    pozitie += (long long) buffere[i].size();
+                }
+                sfarsitUrmator += (long long) buffere[i].size();
+            }
+            if (fir == 0) {
+                urmatorulBloc.store(sfarsit, memory_order_relaxed);
+            }
+            copy(buffer.begin(), buffer.end(), coada.begin() + pozitie);
+            bariera.asteptare();
+
+            buffer.clear();
+            inceput = sfarsit;
+            sfarsit = sfarsitUrmator;
+        }
+    });
+
+    vector<int> distanta(nrNoduri + 1);
+    for (int nod = 0; nod <= nrNoduri; nod++) {
+        distanta[nod] = distantaAtomica[nod].load(memory_order_relaxed);
+    }
+    return distanta;
+}
+
+/*
+ * Motorul comun al parcurgerilor in inaltime: DFS iterativ cu stiva explicita de cadre, memorata contiguu,
+ * astfel incat adancimea parcurgerii nu mai este limitata de stiva de apeluri (un drum cu 10^8 noduri ocupa
+ * 10^8 cadre in memoria heap) si nu mai platim un apel de functie pentru fiecare nod
+ * Vecinii sunt examinati in ordinea din lista, iar evenimentele vizitatorului apar in aceeasi ordine ca
+ * in varianta recursiva (vezi VizitatorDFS)
+ * Stiva este a firului de executie si este refolosita intre apeluri; daca un eveniment porneste la randul lui
+ * o parcurgere, aceasta primeste o stiva proprie
+ */
+template<typename Vizitator>
+void Graf::parcurgereDFS(const int radacina, Vizitator &vizitator) {
+    thread_local vector<CadruDFS> stivaFir;
+    thread_local bool stivaOcupata = false;
+    vector<CadruDFS> stivaLocala;
+    const bool parcurgereExterioara = !stivaOcupata;
+    vector<CadruDFS> &stiva = parcurgereExterioara ? stivaFir : stivaLocala;
+    stivaOcupata = true;
+    stiva.clear();
+
+    vizitator.marcare(radacina);
+    INSTR_CONTOR(NODURI_VIZITATE, 1);
+    INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(radacina) - inceputAdiacenta(radacina));
+    vizitator.intrare(radacina, 0);
+    stiva.push_back({radacina, 0, 0});
+
+    while (!stiva.empty()) {
+        CadruDFS &cadru = stiva.back();
+        const int nod = cadru.nod;
+        const int *vecini = inceputAdiacenta(nod);
+        if (cadru.pozitie < sfarsitAdiacenta(nod) - vecini) { // mai sunt vecini de examinat
+            const long long pozitie = cadru.pozitie++;
+            const int vecin = vecini[pozitie];
+            if (!vizitator.vizitat(vecin)) {
+                vizitator.muchieArbore(nod, vecin, pozitie);
+                vizitator.marcare(vecin);
+                INSTR_CONTOR(NODURI_VIZITATE, 1);
+                INSTR_CONTOR(MUCHII_SCANATE, sfarsitAdiacenta(vecin) - inceputAdiacenta(vecin));
+                vizitator.intrare(vecin, nod);
+                stiva.push_back({vecin, nod, 0}); // cadru nu mai este valid dupa push_back
+            } else {
+                vizitator.muchieInapoi(nod, vecin, pozitie);
+            }
+        } else {
+            const int parinte = cadru.parinte;
+            stiva.pop_back();
+            vizitator.iesire(nod, parinte);
+            if (!stiva.empty()) {
+                vizitator.revenire(parinte, nod, stiva.back().pozitie - 1);
+            }
+        }
+    }
+
+    if (parcurgereExterioara) {
+        stivaOcupata = false;
+    }
+}
+
+/*
+ * Parcurgere in inaltime
+ * nod = nodul de start
+ * vizitate = vector in care sunt marcate nodurile vizitate
+ */
+void Graf::DFS(const int nod, vector<int> &vizitate) {
+    VizitatorVector vizitator(vizitate);
+    parcurgereDFS(nod, vizitator);
+}
+
+/*
+ * Varianta a DFS-ului care marcheaza nodurile in spatiul de lucru, fara un vector de vizitate alocat de apelant
+ */
+void Graf::DFS(const int nod, SpatiuLucru &spatiu) {
+    VizitatorSpatiu vizitator(spatiu);
+    parcurgereDFS(nod, vizitator);
+}
+
+/*
+ * Functie care ia fiecare nod nevizitat al grafului si cu ajutorul DFS viziteaza toate nodurile care au drum catre nodurile curent (practic viziteaza o componenta conexa)
+ * Returneaza numarul de componente conexe
+ */
+int Graf::componenteConexe() {
+    INSTR_FAZA("Graf::componenteConexe");
+    int ct = 0;
+    vector<int> vizitate(nrNoduri + 1, 0);
+    for (int i = 1; i <= nrNoduri; i++) {
+        if (vizitate[i] == 0) {
+            ct++;
+            DFS(i, vizitate);
+        }
+    }
+    return ct;
+}
+
+/*
+ * Ia fiecare nod nevizitat incepand de la startPos si aplica DFS din el
+ * (pastrata pentru compatibilitate; recursivitatea pe startPos a fost inlocuita cu o bucla)
+ * vizitate = vectorul in care sunt marcate nodurile vizitate
+ * startPos = un index folosit pentru a parcurge nodurile, are valoare default 1
+ * Returneaza numarul de componente conexe
+ */
+int Graf::componenteConexeRecursiv(vector<int> &vizitate, const int startPos) {
+    int ct = 0;
+    for (int i = startPos; i <= nrNoduri; i++) {
+        if (vizitate[i] == 0) {
+            ct++;
+            DFS(i, vizitate);
+        }
+    }
+    return ct;
+}
+
+/*
+ * Componentele conexe calculate in paralel (Afforest): fiecare nod are o eticheta comp[nod], initial chiar nodul,
+ * care formeaza o padure; o muchie u-v leaga arborii capetelor agatand radacina mai mare de cea mai mica printr-un CAS
+ * (hooking), iar dupa fiecare etapa drumurile sunt scurtate pana la radacina (shortcutting)
+ * Intai fiecare nod isi leaga doar primii NR_RUNDE vecini, ceea ce pe grafurile mari formeaza deja componenta gigant;
+ * aceasta este gasita prin esantionare, iar restul muchiilor este parcurs doar din nodurile aflate in afara ei,
+ * asa ca majoritatea muchiilor nu mai sunt citite deloc
+ * Pentru un graf orientat se calculeaza componentele slab conexe: nodurile din afara componentei gigant isi leaga
+ * si arcele care intra in ele (din transpus), ca niciun arc sa nu fie omis
+ * componenta[nod] = indicele componentei lui nod (1, 2, ... in ordinea celui mai mic nod din fiecare componenta)
+ * nrFire = numarul de fire de executie (0 -> numarul de nuclee)
+ * Returneaza numarul de componente
+ */
+int Graf::componenteConexeParalel(vector<int> &componenta, int nrFire) {
+    INSTR_FAZA("Graf::componenteConexeParalel");
+    const int NR_RUNDE = 2, DIMENSIUNE_BLOC = 1024, NR_ESANTIOANE = 1024;
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
+    }
+    nrFire = max(1, min(nrFire, nrNoduri / DIMENSIUNE_BLOC + 1));
+    componenta.assign(nrNoduri + 1, 0);
+    if (nrNoduri == 0) {
+        return 0;
+    }
+    if (esteOrientat) {
+        constructieTranspus();
+    }
+
+    vector<atomic<int>> comp(nrNoduri + 1);
+    vector<int> radacini(nrFire + 1, 0); // radacini[fir + 1] = cate componente au cel mai mic nod in intervalul firului
+    atomic<int> urmatorulBloc[NR_RUNDE + 1];
+    for (auto &it: urmatorulBloc) {
+        it.store(0);
+    }
+    int componentaGigant = 0;
+    BarieraFire bariera(nrFire);
+
+    // uneste arborii nodurilor u si v; radacina unui arbore este mereu cel mai mic nod al lui
+    auto legare = [&](const int u, const int v) {
+        int p1 = comp[u].load(memory_order_relaxed), p2 = comp[v].load(memory_order_relaxed);
+        while (p1 != p2) {
+            int mare = max(p1, p2), mic = min(p1, p2);
+            int parinteMare = comp[mare].load(memory_order_relaxed);
+            if (parinteMare == mic ||
+                (parinteMare == mare && comp[mare].compare_exchange_strong(parinteMare, mic))) {
+                break;
+            }
+            p1 = comp[comp[mare].load(memory_order_relaxed)].load(memory_order_relaxed);
+            p2 = comp[mic].load(memory_order_relaxed);
+        }
+    };
+
+    executieParalela(nrFire, [&](int fir) {
+        // fiecare fir are un interval fix de noduri pentru initializare, scurtare si numerotare
+        const int inceput = (int) (1 + (long long) nrNoduri * fir / nrFire);
+        const int sfarsit = (int) (1 + (long long) nrNoduri * (fir + 1) / nrFire);
+        auto scurtare = [&]() {
+            for (int nod = inceput; nod < sfarsit; nod++) {
+                int parinte = comp[nod].load(memory_order_relaxed);
+                while (parinte != comp[parinte].load(memory_order_relaxed)) {
+                    parinte = comp[parinte].load(memory_order_relaxed);
+                }
+                comp[nod].store(parinte, memory_order_relaxed);
+            }
+        };
+
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            comp[nod].store(nod, memory_order_relaxed);
+        }
+        bariera.asteptare();
+
+        // legarea celui de-al runda-lea vecin al fiecarui nod; blocurile sunt luate dinamic, gradele fiind inegale
+        for (int runda = 0; runda < NR_RUNDE; runda++) {
+            for (long long bloc = urmatorulBloc[runda].fetch_add(1); bloc * DIMENSIUNE_BLOC < nrNoduri;
+                 bloc = urmatorulBloc[runda].fetch_add(1)) {
+                int ultimul = (int) min((long long) nrNoduri, (bloc + 1) * DIMENSIUNE_BLOC);
+                for (int nod = (int) (bloc * DIMENSIUNE_BLOC + 1); nod <= ultimul; nod++) {
+                    if (runda < sfarsitAdiacenta(nod) - inceputAdiacenta(nod)) {
+                        legare(nod, inceputAdiacenta(nod)[runda]);
+                    }
+                }
+            }
+            bariera.asteptare();
+            scurtare();
+            bariera.asteptare();
+        }
+
+        // cea mai frecventa eticheta dintre NR_ESANTIOANE noduri aleatoare aproximeaza componenta gigant
+        if (fir == 0) {
+            unsigned long long stare = 88172645463325252ULL;
+            vector<int> esantion(NR_ESANTIOANE);
+            for (int &it: esantion) {
+                it = comp[xorshift(stare) % nrNoduri + 1].load(memory_order_relaxed);
+            }
+            sort(esantion.begin(), esantion.end());
+            for (int i = 0, lungimeMaxima = 0; i < NR_ESANTIOANE;) {
+                int j = i;
+                while (j < NR_ESANTIOANE && esantion[j] == esantion[i]) {
+                    j++;
+                }
+                if (j - i > lungimeMaxima) {
+                    lungimeMaxima = j - i;
+                    componentaGigant = esantion[i];
+                }
+                i = j;
+            }
+        }
+        bariera.asteptare();
+
+        // muchiile ramase, doar pentru nodurile din afara componentei gigant
+        for (long long bloc = urmatorulBloc[NR_RUNDE].fetch_add(1); bloc * DIMENSIUNE_BLOC < nrNoduri;
+             bloc = urmatorulBloc[NR_RUNDE].fetch_add(1)) {
+            int ultimul = (int) min((long long) nrNoduri, (bloc + 1) * DIMENSIUNE_BLOC);
+            for (int nod = (int) (bloc * DIMENSIUNE_BLOC + 1); nod <= ultimul; nod++) {
+                if (comp[nod].load(memory_order_relaxed) == componentaGigant) {
+                    continue;
+                }
+                for (const int *it = inceputAdiacenta(nod) + min<long long>(NR_RUNDE, sfarsitAdiacenta(nod) -
+                                                                                      inceputAdiacenta(nod));
+                     it != sfarsitAdiacenta(nod); it++) {
+                    legare(nod, *it);
+                }
+                if (esteOrientat) {
+                    for (const int *it = inceputIntrari(nod); it != sfarsitIntrari(nod); it++) {
+                        legare(nod, *it);
+                    }
+                }
+            }
+        }
+        bariera.asteptare();
+        scurtare();
+        bariera.asteptare();
+
+        // numerotarea componentelor: radacinile (comp[nod] == nod) primesc indici consecutivi, in ordinea nodurilor
+        int nrRadacini = 0;
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            nrRadacini += comp[nod].load(memory_order_relaxed) == nod;
+        }
+        radacini[fir + 1] = nrRadacini;
+        bariera.asteptare();
+        int indice = 0;
+        for (int i = 1; i <= fir; i++) {
+            indice += radacini[i];
+        }
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            if (comp[nod].load(memory_order_relaxed) == nod) {
+                componenta[nod] = ++indice;
+            }
+        }
+        bariera.asteptare();
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            int radacina = comp[nod].load(memory_order_relaxed);
+            if (radacina != nod) { // radacinile sunt citite de celelalte fire, deci nu sunt rescrise
+                componenta[nod] = componenta[radacina];
+            }
+        }
+    });
+
+    int nrComponente = 0;
+    for (int i = 1; i <= nrFire; i++) {
+        nrComponente += radacini[i];
+    }
+    return nrComponente;
+}
+
+/*
+ * Elimina pe rand fiecare muchie (in O(1), dupa id) si verifica cu DFS daca al doilea capat mai poate fi atins
+ */
+vector<vector<int>> Graf::muchiiCritice_neeficient() {
+    INSTR_FAZA("Graf::muchiiCritice_neeficient");
+    dezghetare();
+    vector<vector<int>> result;
+
+    // parcurgem fiecare muchie a grafului si o eliminam
+    for (int id = 0; id < this->nrMuchii; id++) {
+        if (this->pozitieMuchie[2 * id] == 0) { // muchia a fost eliminata inainte de apel
+            continue;
+        }
+        int nod = this->capeteMuchie[2 * id], nodAdiacentCurent = this->capeteMuchie[2 * id + 1];
+        eliminareMuchieId(id);
+        // spatiul de lucru este golit in O(1), in loc sa alocam un vector de vizitate pentru fiecare muchie
+        SpatiuLucru &spatiu = SpatiuLucru::alFirului();
+        spatiu.pregatire(this->nrNoduri);
+        DFS(nod, spatiu);
+        if (!spatiu.vizitat(nodAdiacentCurent)) {
+            result.push_back({nod, nodAdiacentCurent});
+        }
+        reinserareMuchie(id);
+    }
+    return result;
+}
+
+/*
+ * O muchie [a,b] este muchie critica daca nu exista niciun drum de la descendentii lui b la a sau ascendentii sai
+ * Momentele de vizitare sunt numerotate de la 1 in fiecare componenta; low_time este comparat doar intre
+ * noduri din aceeasi componenta, deci nu mai e nevoie de un contor static intre apeluri
+ */
+void
+Graf::MuchieCritica(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
+                    vector<vector<int>> &result) {
+
+    struct Vizitator : VizitatorVector {
+        vector<int> &time, &low_time, &parent;
+        vector<vector<int>> &result;
+        int t = 0;
+
+        Vizitator(vector<int> &vizitate, vector<int> &time, vector<int> &low_time, vector<int> &parent,
+                  vector<vector<int>> &result)
+                : VizitatorVector(vizitate), time(time), low_time(low_time), parent(parent), result(result) {}
+
+        void intrare(const int nod, const int parinte) {
+            if (parinte != 0) {
+                parent[nod] = parinte; // tinem minte parintele
+            }
+            t++;
+            low_time[nod] = t;
+            time[nod] = low_time[nod];
+        }
+
+        void muchieInapoi(const int nod, const int nodAdiacentCurent, long long) {
+            if (nodAdiacentCurent != parent[nod]) {
+                low_time[nod] = min(low_time[nod], time[nodAdiacentCurent]);
+            }
+        }
+
+        void revenire(const int nod, const int nodAdiacentCurent, long long) {
+            // actualizam low_time[nod] daca nodAdiacentCurent are muchie cu un parinte al nodului sau cu nodul
+            low_time[nod] = min(low_time[nod], low_time[nodAdiacentCurent]);
+            // conditia ca muchia [nod,nodAdiacentCurent] sa fie critica (sa nu aiba drum la nod sau ascendentii sai)
+            if (low_time[nodAdiacentCurent] > time[nod]) {
+                result.push_back({nod, nodAdiacentCurent});
+            }
+        }
+    } vizitator(vizitate, time, low_time, parent, result);
+
+    parcurgereDFS(nod, vizitator);
+}
+
+/*
+ * La fel ca MuchieCritica, dar muchia critica [nod, fiu] este marcata prin result[i] = 1,
+ * unde i este pozitia fiului (numerotata de la 1) in lista de adiacenta a nodului
+ */
+void
+Graf::dfs_pamant(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
+                 vector<int> &result) {
+
+    struct Vizitator : VizitatorVector {
+        vector<int> &time, &low_time, &parent, &result;
+        int t = 0;
+
+        Vizitator(vector<int> &vizitate, vector<int> &time, vector<int> &low_time, vector<int> &parent,
+                  vector<int> &result)
+                : VizitatorVector(vizitate), time(time), low_time(low_time), parent(parent), result(result) {}
+
+        void intrare(const int nod, const int parinte) {
+            if (parinte != 0) {
+                parent[nod] = parinte;
+            }
+            t++;
+            low_time[nod] = t;
+            time[nod] = low_time[nod];
+        }
+
+        void muchieInapoi(const int nod, const int nodAdiacentCurent, long long) {
+            if (nodAdiacentCurent != parent[nod]) {
+                low_time[nod] = min(low_time[nod], time[nodAdiacentCurent]);
+            }
+        }
+
+        void revenire(const int nod, const int nodAdiacentCurent, const long long pozitie) {
+            low_time[nod] = min(low_time[nod], low_time[nodAdiacentCurent]);
+            if (low_time[nodAdiacentCurent] > time[nod]) {
+                result[pozitie + 1] = 1;
+            }
+        }
+    } vizitator(vizitate, time, low_time, parent, result);
+
+    parcurgereDFS(nod, vizitator);
+}
+
+/*
+ * Ia fiecare nod al grafului si apeleaza functia MuchiCritica
+ */
+vector<vector<int>> Graf::DFS_muchiiCritice() {
+    INSTR_FAZA("Graf::DFS_muchiiCritice");
+    // time = vector in care tinem minte momentul in care un nod a fost vizitat
+    // low_time = vector in care tinem minte muchia vizitata cel mai devreme
+    // parent = vector care retine parintele nodurilor
+    vector<int> vizitate(nrNoduri + 1, 0), parent(nrNoduri + 1, -1), time(nrNoduri + 1), low_time(nrNoduri + 1);
+    vector<vector<int>> result;
+
+    // parcurgem fiecare nod al grafului
+    for (int i = 1; i <= this->nrNoduri; i++) {
+        if (!vizitate[i]) {
+            MuchieCritica(i, time, low_time, parent, vizitate, result);
+        }
+    }
+    return result;
+}
+
+/*
+ * Puntile si punctele de articulatie ale unui graf neorientat, intr-o singura parcurgere DFS iterativa (low-link)
+ * Muchia parintelui este recunoscuta dupa id, nu dupa nodul parinte, asa ca muchiile multiple nu sunt punti
+ * Toata starea este locala apelului, deci functia poate fi apelata repetat si din mai multe fire (pe grafuri diferite)
+ * punti = id-urile muchiilor critice, in ordinea in care sunt gasite
+ * articulatii = nodurile de articulatie, in post-ordinea parcurgerii
+ */
+void Graf::puntiSiArticulatii(vector<int> &punti, vector<int> &articulatii) {
+    INSTR_FAZA("Graf::puntiSiArticulatii");
+    punti.clear();
+    articulatii.clear();
+
+    // timp[nod] = momentul vizitarii (0 = nevizitat), minim[nod] = cel mai mic moment atins din subarborele lui nod
+    // printr-o singura muchie de intoarcere, muchieParinte[nod] = id-ul muchiei prin care a fost atins nod
+    struct Vizitator : VizitatorDFS {
+        const Graf &graf;
+        vector<int> &punti, &articulatii;
+        vector<int> timp, minim, muchieParinte;
+        vector<char> esteArticulatie;
+        int t = 0, radacina = 0, fiiRadacina = 0;
+
+        Vizitator(const Graf &graf, vector<int> &punti, vector<int> &articulatii)
+                : graf(graf), punti(punti), articulatii(articulatii), timp(graf.nrNoduri + 1, 0),
+                  minim(graf.nrNoduri + 1), muchieParinte(graf.nrNoduri + 1, -1),
+                  esteArticulatie(graf.nrNoduri + 1, 0) {}
+
+        bool vizitat(const int nod) const {
+            return timp[nod] != 0;
+        }
+
+        void marcare(const int nod) {
+            timp[nod] = minim[nod] = ++t;
+        }
+
+        void muchieArbore(const int nod, const int fiu, const long long pozitie) {
+            muchieParinte[fiu] = graf.inceputIdMuchii(nod)[pozitie];
+            fiiRadacina += nod == radacina;
+        }
+
+        void muchieInapoi(const int nod, const int vecin, const long long pozitie) {
+            if (graf.inceputIdMuchii(nod)[pozitie] != muchieParinte[nod]) {
+                minim[nod] = min(minim[nod], timp[vecin]);
+            }
+        }
+
+        void revenire(const int nod, const int fiu, long long) {
+            minim[nod] = min(minim[nod], minim[fiu]);
+            if (minim[fiu] > timp[nod]) {
+                punti.push_back(muchieParinte[fiu]);
+            }
+            if (minim[fiu] >= timp[nod] && nod != radacina) {
+                esteArticulatie[nod] = 1;
+            }
+        }
+
+        void iesire(const int nod, int) {
+            if (esteArticulatie[nod] || (nod == radacina && fiiRadacina >= 2)) {
+                articulatii.push_back(nod);
+            }
+        }
+    } vizitator(*this, punti, articulatii);
+
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        if (!vizitator.vizitat(nod)) {
+            vizitator.radacina = nod;
+            vizitator.fiiRadacina = 0;
+            parcurgereDFS(nod, vizitator);
+        }
+    }
+}
+
+/*
+ * Porneste mentinerea incrementala a puntilor (vezi PuntiIncrementale): de acum adaugareMuchie si reinserareMuchie
+ * actualizeaza puntile in timp amortizat aproape constant, fara o noua parcurgere a grafului
+ * Intr-un graf orientat arcele sunt considerate neorientate
+ */
+void Graf::urmarirePunti() {
+    urmarestePunti = true;
+    if (!puntiActuale) {
+        reconstructiePunti();
+    }
+}
+
+/*
+ * Reface structura din muchiile existente (fiecare muchie apare o singura data: in lista capatului mai mic,
+ * iar intr-un graf orientat in lista nodului de start)
+ */
+void Graf::reconstructiePunti() {
+    puntiIncrementale = PuntiIncrementale(nrNoduri);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+            if (esteOrientat || nod < *it) {
+                puntiIncrementale.adaugareMuchie(nod, *it);
+            }
+        }
+    }
+    puntiActuale = true;
+}
+
+/*
+ * true daca exista o muchie x-y si ea este punte
+ * Porneste urmarirea puntilor daca nu era pornita
+ */
+bool Graf::estePunte(const int x, const int y) {
+    urmarirePunti();
+    return puntiIncrementale.estePunte(x, y);
+}
+
+/*
+ * Numarul curent de punti; porneste urmarirea puntilor daca nu era pornita
+ */
+int Graf::numarPunti() {
+    urmarirePunti();
+    return puntiIncrementale.numarPunti();
+}
+
+/*
+ * Porneste mentinerea incrementala a ordinii topologice a unui graf orientat (vezi OrdineTopologicaIncrementala):
+ * de acum adaugareMuchie si reinserareMuchie reordoneaza doar regiunea afectata de arcul nou si refuza arcele care
+ * ar inchide un ciclu, iar eliminarile doar scot arcul (ordinea ramane valabila)
+ * Returneaza false daca graful nu este orientat sau are deja un ciclu; in acest caz nu este refuzat niciun arc
+ */
+bool Graf::urmarireOrdineTopologica() {
+    urmaresteOrdinea = true;
+    if (!ordineActuala) {
+        reconstructieOrdine();
+    }
+    return !grafCuCiclu;
+}
+
+/*
+ * Reface ordinea cu o sortare topologica a grafului curent, dupa care toate arcele existente sunt adaugate
+ * in O(1) fiecare (merg deja inainte in ordine)
+ */
+void Graf::reconstructieOrdine() {
+    vector<int> ordine, nivel, ciclu;
+    ordineActuala = true;
+    grafCuCiclu = !esteOrientat || sortareTopologicaParalel(ordine, nivel, ciclu, 1) == -1;
+    if (grafCuCiclu) {
+        ordineIncrementala = OrdineTopologicaIncrementala();
+        return;
+    }
+    ordineIncrementala = OrdineTopologicaIncrementala(nrNoduri, ordine);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+            ordineIncrementala.adaugareArc(nod, *it);
+        }
+    }
+}
+
+/*
+ * Pozitia nodului (0, 1, ...) in ordinea topologica curenta, in O(1); -1 daca graful are un ciclu
+ * Porneste urmarirea ordinii daca nu era pornita
+ */
+int Graf::pozitieTopologica(const int nod) {
+    return urmarireOrdineTopologica() ? ordineIncrementala.pozitieNod(nod) : -1;
+}
+
+/*
+ * Ordinea topologica curenta (gol daca graful are un ciclu); porneste urmarirea ordinii daca nu era pornita
+ */
+const vector<int> &Graf::ordineTopologicaCurenta() {
+    static const vector<int> gol;
+    return urmarireOrdineTopologica() ? ordineIncrementala.ordine() : gol;
+}
+
+/*
+ * Componentele biconexe (blocurile) ale unui graf neorientat si arborele bloc-articulatie, intr-o singura parcurgere
+ * DFS iterativa: muchiile de arbore si de intoarcere sunt puse pe o stiva de id-uri, iar cand un fiu nu poate urca
+ * mai sus de nod (minim[fiu] >= timp[nod]) muchiile de deasupra muchiei nod-fiu formeaza un bloc
+ * Doua muchii sunt in acelasi bloc daca si numai daca se afla pe un ciclu simplu comun, deci nodurile unui bloc
+ * cad impreuna doar daca cade unul din punctele de articulatie care il separa de restul grafului
+ * blocMuchie[id] = blocul muchiei id (1, 2, ...), 0 pentru bucle si muchiile eliminate
+ * articulatii = punctele de articulatie, crescator
+ * Returneaza arborele (padurea, daca graful nu e conex) bloc-articulatie in forma CSR: nodurile 1..nrBlocuri sunt
+ * blocurile, nodul nrBlocuri + i este articulatii[i - 1], iar fiecare articulatie este legata de blocurile din care face parte
+ */
+Graf Graf::componenteBiconexe(vector<int> &blocMuchie, vector<int> &articulatii) {
+    INSTR_FAZA("Graf::componenteBiconexe");
+    blocMuchie.assign(nrMuchii, 0);
+    articulatii.clear();
+
+    // sus[b] = nodul cel mai apropiat de radacina din blocul b (toate celelalte noduri ale blocului sunt sub el)
+    struct Vizitator : VizitatorDFS {
+        const Graf &graf;
+        vector<int> &blocMuchie;
+        vector<int> timp, minim, muchieParinte, stivaMuchii, sus;
+        int t = 0;
+
+        Vizitator(const Graf &graf, vector<int> &blocMuchie)
+                : graf(graf), blocMuchie(blocMuchie), timp(graf.nrNoduri + 1, 0), minim(graf.nrNoduri + 1),
+                  muchieParinte(graf.nrNoduri + 1, -1), sus(1, 0) {}
+
+        bool vizitat(const int nod) const {
+            return timp[nod] != 0;
+        }
+
+        void marcare(const int nod) {
+            timp[nod] = minim[nod] = ++t;
+        }
+
+        void muchieArbore(const int nod, const int fiu, const long long pozitie) {
+            muchieParinte[fiu] = graf.inceputIdMuchii(nod)[pozitie];
+            stivaMuchii.push_back(muchieParinte[fiu]);
+        }
+
+        void muchieInapoi(const int nod, const int vecin, const long long pozitie) {
+            int id = graf.inceputIdMuchii(nod)[pozitie];
+            // muchiile catre descendenti au fost deja puse pe stiva de celalalt capat, iar buclele nu intra in niciun bloc
+            if (id != muchieParinte[nod] && timp[vecin] < timp[nod]) {
+                minim[nod] = min(minim[nod], timp[vecin]);
+                stivaMuchii.push_back(id);
+            }
+        }
+
+        void revenire(const int nod, const int fiu, long long) {
+            minim[nod] = min(minim[nod], minim[fiu]);
+            if (minim[fiu] >= timp[nod]) {
+                int bloc = (int) sus.size();
+                sus.push_back(nod);
+                int id;
+                do {
+                    id = stivaMuchii.back();
+                    stivaMuchii.pop_back();
+                    blocMuchie[id] = bloc;
+                } while (id != muchieParinte[fiu]);
+            }
+        }
+    } vizitator(*this, blocMuchie);
+
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        if (!vizitator.vizitat(nod)) {
+            parcurgereDFS(nod, vizitator);
+        }
+    }
+
+    // un nod face parte din blocul muchiei prin care a fost atins si din toate blocurile in care este cel mai de sus;
+    // este punct de articulatie daca face parte din cel putin doua blocuri
+    const int nrBlocuri = (int) vizitator.sus.size() - 1;
+    vector<int> nrApartenente(nrNoduri + 1, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        nrApartenente[nod] += vizitator.muchieParinte[nod] != -1;
+    }
+    for (int bloc = 1; bloc <= nrBlocuri; bloc++) {
+        nrApartenente[vizitator.sus[bloc]]++;
+    }
+    vector<int> &indiceArticulatie = vizitator.minim; // refolosit: nodul din arbore al fiecarei articulatii
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        if (nrApartenente[nod] >= 2) {
+            articulatii.push_back(nod);
+            indiceArticulatie[nod] = nrBlocuri + (int) articulatii.size();
         }
     }
-}
 
+    vector<pair<int, int>> muchiiArbore;
+    for (int bloc = 1; bloc <= nrBlocuri; bloc++) {
+        if (nrApartenente[vizitator.sus[bloc]] >= 2) {
+            muchiiArbore.push_back({bloc, indiceArticulatie[vizitator.sus[bloc]]});
+        }
+    }
+    for (int nod: articulatii) {
+        if (vizitator.muchieParinte[nod] != -1) {
+            muchiiArbore.push_back({blocMuchie[vizitator.muchieParinte[nod]], indiceArticulatie[nod]});
+        }
+    }
+    return Graf(nrBlocuri + (int) articulatii.size(), muchiiArbore, false);
+}
 
 /*
- * Calculeaza distanta minima de la fiecare nod la start si o afiseaza
- * out = stream-ul de iesire
- * start = nodul de start
+ * Componentele tare conexe, cu algoritmul lui Tarjan pe motorul DFS iterativ (o singura parcurgere, O(n + m))
+ * Componentele sunt numerotate in ordine topologica: orice arc intre doua componente merge de la un indice mai mic
+ * la unul mai mare (Tarjan le gaseste in ordine inversa, incepand cu cele fara arce de iesire)
+ * componenta[nod] = indicele componentei lui nod (1, 2, ...)
+ * Returneaza condensarea: graful orientat aciclic, in forma CSR, cu cate un nod pentru fiecare componenta si cate un arc
+ * pentru fiecare pereche de componente legate; poate fi dat direct lui DFS_sortareTopologica
+ * Intr-un graf neorientat componentele sunt chiar componentele conexe, iar condensarea nu are arce
  */
-vector<int> Graf::distantaMinimaBFS(ostream &out, int start) {
-    // Vector pentru distanta in care fiecare element este initial -1
-    vector<int> distanta(nrNoduri + 1, -1);
-    distanta[start] = 0;
-
-    // Queue in care salvam elementele care trebuiesc vizitate. Cand se goleste, nu mai avem nimic de vizitat
-    queue<int> queue;
-    queue.push(start);
-
-    while (!queue.empty()) {
-        start = queue.front();
-        queue.pop();
-        for (auto it: matriceAdiacenta[start]) { // parcurgem fiecare nod adiacent al nodului curent
-            // Daca nu a fost vizitat inca
-            if (distanta[it] == -1) {
-                distanta[it] = distanta[start] + 1;
-                queue.push(it); // Il adaugam in coada pentru a fi vizitat
-            }
+Graf Graf::componenteTareConexe(vector<int> &componenta) {
+    INSTR_FAZA("Graf::componenteTareConexe");
+    VizitatorTarjan vizitator(nrNoduri);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        if (!vizitator.vizitat(nod)) {
+            parcurgereDFS(nod, vizitator);
         }
     }
 
-    // Returnam distanta
-    return distanta;
-
+    const int nrComponente = (int) vizitator.radacini.size();
+    vector<int> &indice = vizitator.minim; // refolosit: indicele componentei fiecarei radacini
+    for (int i = 0; i < nrComponente; i++) {
+        indice[vizitator.radacini[i]] = nrComponente - i;
+    }
+    componenta.assign(nrNoduri + 1, 0);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        componenta[nod] = indice[vizitator.eticheta[nod]];
+    }
+    return condensare(componenta, nrComponente);
 }
 
 /*
- * Parcurgere in inaltime
- * nod = nodul curent
- * vizitate = vector in care sunt marcate nodurile vizitate
+ * Condensarea grafului dupa o impartire a nodurilor in componente numerotate 1..nrComponente
+ * Nodurile sunt grupate pe componente (sortare prin numarare), iar arcele repetate catre aceeasi componenta sunt
+ * eliminate cu un marcaj per componenta, totul in O(n + m)
  */
-void Graf::DFS(const int nod, vector<int> &vizitate) {
-    vizitate[nod] = 1;
-    for (int i = 1; i < matriceAdiacenta[nod].size(); i++) { // parcurgem nodurile adiacente nodului curent
-        if (vizitate[matriceAdiacenta[nod][i]] == 0) { // daca nu a fost vizitat
-            DFS(matriceAdiacenta[nod][i], vizitate);
+Graf Graf::condensare(const vector<int> &componenta, const int nrComponente) {
+    vector<int> inceput(nrComponente + 2, 0), noduri(nrNoduri);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        inceput[componenta[nod] + 1]++;
+    }
+    for (int c = 1; c <= nrComponente + 1; c++) {
+        inceput[c] += inceput[c - 1];
+    }
+    vector<int> pozitie(inceput.begin(), inceput.end() - 1);
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        noduri[pozitie[componenta[nod]]++] = nod;
+    }
+
+    vector<int> ultimaSursa(nrComponente + 1, 0);
+    vector<pair<int, int>> arce;
+    for (int c = 1; c <= nrComponente; c++) {
+        for (int i = inceput[c]; i < inceput[c + 1]; i++) {
+            for (const int *it = inceputAdiacenta(noduri[i]); it != sfarsitAdiacenta(noduri[i]); it++) {
+                int destinatie = componenta[*it];
+                if (destinatie != c && ultimaSursa[destinatie] != c) {
+                    ultimaSursa[destinatie] = c;
+                    arce.push_back({c, destinatie});
+                }
+            }
         }
     }
+    return Graf(nrComponente, arce, true);
 }
 
 /*
- * Functie care ia fiecare nod nevizitat al grafului si cu ajutorul DFS viziteaza toate nodurile care au drum catre nodurile curent (practic viziteaza o componenta conexa)
- * Returneaza numarul de componente conexe
+ * BFS paralel pe niveluri (ca distantaMinimaBFSParalel) care trece doar prin nodurile cu marcaj == dinStare,
+ * schimbandu-le marcajul in inStare; start trebuie sa fie deja marcat cu inStare
+ * inapoi = true -> arcele sunt parcurse invers (din transpus, care trebuie sa fie construit)
  */
-int Graf::componenteConexe() {
-    int ct = 0;
-    vector<int> vizitate(nrNoduri + 1, 0);
-    for (int i = 1; i <= nrNoduri; i++) {
-        if (vizitate[i] == 0) {
-            ct++;
-            DFS(i, vizitate);
+void Graf::BFSParalelMarcaje(const int start, const bool inapoi, vector<atomic<int>> &marcaj, const int dinStare,
+                             const int inStare, const int nrFire) {
+    const long long marimeBloc = 64;
+    vector<int> coada(nrNoduri + 1);
+    coada[0] = start;
+    atomic<long long> urmatorulBloc(0);
+    vector<vector<int>> buffere(nrFire);
+    BarieraFire bariera(nrFire);
+
+    executieParalela(nrFire, [&](int fir) {
+        vector<int> &buffer = buffere[fir];
+        long long sfarsit = 1;
+        for (long long inceput = 0; inceput < sfarsit;) {
+            for (long long bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed);
+                 bloc < sfarsit; bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed)) {
+                for (long long i = bloc; i < min(bloc + marimeBloc, sfarsit); i++) {
+                    int nod = coada[i];
+                    const int *it = inapoi ? inceputIntrari(nod) : inceputAdiacenta(nod);
+                    const int *sfarsitVecini = inapoi ? sfarsitIntrari(nod) : sfarsitAdiacenta(nod);
+                    for (; it != sfarsitVecini; it++) {
+                        int stare = dinStare;
+                        if (marcaj[*it].load(memory_order_relaxed) == dinStare &&
+                            marcaj[*it].compare_exchange_strong(stare, inStare, memory_order_relaxed)) {
+                            buffer.push_back(*it);
+                        }
+                    }
+                }
+            }
+            bariera.asteptare();
+
+            long long pozitie = sfarsit, sfarsitUrmator = sfarsit;
+            for (int i = 0; i < nrFire; i++) {
+                if (i < fir) {
+                    pozitie += (long long) buffere[i].size();
+                }
+                sfarsitUrmator += (long long) buffere[i].size();
+            }
+            if (fir == 0) {
+                urmatorulBloc.store(sfarsit, memory_order_relaxed);
+            }
+            copy(buffer.begin(), buffer.end(), coada.begin() + pozitie);
+            bariera.asteptare();
+
+            buffer.clear();
+            inceput = sfarsit;
+            sfarsit = sfarsitUrmator;
         }
-    }
-    return ct;
+    });
 }
 
 /*
- * Functie recursiva care ia fiecare nod nevizitat si aplica DFS din el
- * Se opreste in momentul in care trece de ultimul nod
- * vizitate = vectorul in care sunt marcate nodurile vizitate
- * startPos = un index folosit pentru a parcurge nodurile, are valoare default 1
- * Returneaza numarul de componente conexe
+ * Componentele tare conexe calculate in paralel, in trei etape:
+ *   1. eliminare (trim): nodurile fara arce de intrare sau de iesire catre nodurile ramase sunt componente de un nod;
+ *      fiecare fir elimina nodurile din intervalul lui si apoi, ca la Kahn, pe cele ramase fara intrari/iesiri
+ *   2. inainte-inapoi (FW-BW): din nodul ramas cu produsul maxim al gradelor se cauta paralel nodurile atinse inainte,
+ *      iar printre ele cele care il ating (inapoi); intersectia este componenta lui, de obicei componenta gigant
+ *   3. colorare: fiecare nod ramas primeste culoarea egala cu el insusi, iar culorile mai mari sunt propagate pe arce
+ *      pana la stabilizare; un nod care isi pastreaza culoarea gaseste, inapoi prin nodurile de aceeasi culoare,
+ *      exact componenta lui (cautarile sunt independente, cate una pe fir). Se repeta cu nodurile ramase.
+ * Cand colorarea nu mai face progrese (lanturi lungi de componente mici) sau au ramas putine noduri,
+ * restul este terminat cu Tarjan, secvential, doar pe nodurile ramase
+ * La sfarsit componentele sunt renumerotate in ordine topologica peste condensare (Kahn), ca la componenteTareConexe:
+ * orice arc intre doua componente merge de la un indice mai mic la unul mai mare. Ordinea topologica nu este unica,
+ * asa ca indicii pot diferi de cei dati de componenteTareConexe; partitia in componente este aceeasi
+ * componenta[nod] = indicele componentei lui nod (1, 2, ...)
+ * nrFire = numarul de fire de executie (0 -> numarul de nuclee)
+ * Returneaza condensarea, ca la componenteTareConexe
  */
-int Graf::componenteConexeRecursiv(vector<int> &vizitate, const int startPos) {
-    if (startPos == nrNoduri + 1) {
-        return 0;
-    } else {
-        if (vizitate[startPos] == 0) { // i nu exista in map => nu a fost vizitat
-            DFS(startPos, vizitate);
-            return 1 + componenteConexeRecursiv(vizitate, startPos + 1);
-        } else {
-            return componenteConexeRecursiv(vizitate, startPos + 1);
+Graf Graf::componenteTareConexeParalel(vector<int> &componenta, int nrFire) {
+    INSTR_FAZA("Graf::componenteTareConexeParalel");
+    const int RUNDE_COLORARE = 64, PRAG_TARJAN = 1024;
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
+    }
+    nrFire = max(1, min(nrFire, nrNoduri / 1024 + 1));
+    constructieTranspus();
+
+    // eticheta[nod] = un nod reprezentant al componentei (0 cat timp nu este cunoscuta)
+    // marcaj[nod] = -1 pentru nodurile cu eticheta; pentru celelalte este starea FW-BW sau culoarea
+    vector<atomic<int>> eticheta(nrNoduri + 1), marcaj(nrNoduri + 1), gradIntrare(nrNoduri + 1),
+            gradIesire(nrNoduri + 1);
+    vector<pair<long long, int>> pivotFir(nrFire, {-1, 0});
+    BarieraFire bariera(nrFire);
+    auto inceputFir = [&](int fir) {
+        return (int) (1 + (long long) nrNoduri * fir / nrFire);
+    };
+    auto revendicare = [&](int nod, int reprezentant) {
+        int libera = 0;
+        return eticheta[nod].compare_exchange_strong(libera, reprezentant, memory_order_relaxed);
+    };
+
+    // 1. eliminarea nodurilor fara intrari sau fara iesiri, apoi alegerea pivotului pentru FW-BW
+    executieParalela(nrFire, [&](int fir) {
+        const int inceput = inceputFir(fir), sfarsit = inceputFir(fir + 1);
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            eticheta[nod].store(0, memory_order_relaxed);
+            gradIntrare[nod].store((int) (sfarsitIntrari(nod) - inceputIntrari(nod)), memory_order_relaxed);
+            gradIesire[nod].store((int) (sfarsitAdiacenta(nod) - inceputAdiacenta(nod)), memory_order_relaxed);
+        }
+        bariera.asteptare();
+
+        vector<int> stiva;
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            if ((gradIntrare[nod].load(memory_order_relaxed) == 0 || gradIesire[nod].load(memory_order_relaxed) == 0)
+                && revendicare(nod, nod)) {
+                stiva.push_back(nod);
+            }
+        }
+        while (!stiva.empty()) {
+            int nod = stiva.back();
+            stiva.pop_back();
+            for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                if (gradIntrare[*it].fetch_sub(1, memory_order_relaxed) == 1 && revendicare(*it, *it)) {
+                    stiva.push_back(*it);
+                }
+            }
+            for (const int *it = inceputIntrari(nod); it != sfarsitIntrari(nod); it++) {
+                if (gradIesire[*it].fetch_sub(1, memory_order_relaxed) == 1 && revendicare(*it, *it)) {
+                    stiva.push_back(*it);
+                }
+            }
+        }
+        bariera.asteptare();
+
+        for (int nod = inceput; nod < sfarsit; nod++) {
+            bool ramas = eticheta[nod].load(memory_order_relaxed) == 0;
+            marcaj[nod].store(ramas ? 0 : -1, memory_order_relaxed);
+            long long produs = (long long) gradIntrare[nod].load(memory_order_relaxed) *
+                               gradIesire[nod].load(memory_order_relaxed);
+            if (ramas && produs > pivotFir[fir].first) {
+                pivotFir[fir] = {produs, nod};
+            }
         }
+    });
+    marcaj[0].store(-1, memory_order_relaxed);
+
+    // 2. componenta pivotului: atinse inainte (marcaj 1), apoi dintre acestea cele care ating pivotul (marcaj 2)
+    int pivot = max_element(pivotFir.begin(), pivotFir.end())->second;
+    if (pivot != 0) {
+        marcaj[pivot].store(1, memory_order_relaxed);
+        BFSParalelMarcaje(pivot, false, marcaj, 0, 1, nrFire);
+        marcaj[pivot].store(2, memory_order_relaxed);
+        BFSParalelMarcaje(pivot, true, marcaj, 1, 2, nrFire);
+        executieParalela(nrFire, [&](int fir) {
+            for (int nod = inceputFir(fir); nod < inceputFir(fir + 1); nod++) {
+                int stare = marcaj[nod].load(memory_order_relaxed);
+                if (stare == 2) {
+                    eticheta[nod].store(pivot, memory_order_relaxed);
+                    marcaj[nod].store(-1, memory_order_relaxed);
+                } else if (stare == 1) {
+                    marcaj[nod].store(0, memory_order_relaxed);
+                }
+            }
+        });
     }
-}
 
-vector<vector<int>> Graf::muchiiCritice_neeficient() {
-    map<pair<int, int>, bool> muchiiVizitate;
-    vector<vector<int>> result;
+    // 3. colorare, cat timp fiecare iteratie elimina macar o zecime din nodurile ramase
+    vector<int> ramase;
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        if (eticheta[nod].load(memory_order_relaxed) == 0) {
+            ramase.push_back(nod);
+        }
+    }
+    bool progres = true;
+    while ((int) ramase.size() > PRAG_TARJAN && progres) {
+        const long long nrRamase = (long long) ramase.size();
+        atomic<int> ultimaRundaCuSchimbari(0), urmatorulBloc(0);
+        bool stabilizat = false;
+        executieParalela(nrFire, [&](int fir) {
+            const long long inceput = nrRamase * fir / nrFire, sfarsit = nrRamase * (fir + 1) / nrFire;
+            for (long long i = inceput; i < sfarsit; i++) {
+                marcaj[ramase[i]].store(ramase[i], memory_order_relaxed);
+            }
+            bariera.asteptare();
+
+            // culoarea unui nod devine maximul culorilor nodurilor din care poate fi atins
+            for (int runda = 1; runda <= RUNDE_COLORARE; runda++) {
+                bool schimbat = false;
+                for (long long i = inceput; i < sfarsit; i++) {
+                    int nod = ramase[i], culoare = marcaj[nod].load(memory_order_relaxed);
+                    for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                        int culoareVecin = marcaj[*it].load(memory_order_relaxed);
+                        while (culoareVecin != -1 && culoareVecin < culoare &&
+                               !marcaj[*it].compare_exchange_weak(culoareVecin, culoare, memory_order_relaxed)) {
+                        }
+                        schimbat = schimbat || (culoareVecin != -1 && culoareVecin < culoare);
+                    }
+                }
+                if (schimbat) {
+                    ultimaRundaCuSchimbari.store(runda, memory_order_relaxed);
+                }
+                bariera.asteptare();
+                bool continuare = ultimaRundaCuSchimbari.load(memory_order_relaxed) == runda;
+                bariera.asteptare();
+                if (!continuare) {
+                    if (fir == 0) {
+                        stabilizat = true;
+                    }
+                    break;
+                }
+            }
+            if (ultimaRundaCuSchimbari.load(memory_order_relaxed) == RUNDE_COLORARE) {
+                return; // culorile nu s-au stabilizat; toate firele vad aceeasi valoare si renunta
+            }
 
-    // parcurgem fiecare muchie a grafului si o eliminam
-    for (int nod = 1; nod <= this->nrNoduri; nod++) {
-        for (int j = 1; j < this->matriceAdiacenta[nod].size(); j++) {
-            int nodAdiacentCurent = this->matriceAdiacenta[nod][j];
-            if (muchiiVizitate.find(make_pair(nod, nodAdiacentCurent)) == muchiiVizitate.end()) {
-                eliminareMuchie(nod, nodAdiacentCurent);
-                vector<int> vizitateAux(this->nrNoduri + 1, 0);
-                DFS(nod, vizitateAux);
-                for (int i = 1; i <= this->nrNoduri; i++) {
-                    if (vizitateAux[i] == 0) {
-                        // cout << nod << " " << nodAdiacentCurent << '\n';
-                        vector<int> pair;
-                        pair.push_back(nod);
-                        pair.push_back(nodAdiacentCurent);
-                        result.push_back(pair);
-                        break;
+            // fiecare nod care si-a pastrat culoarea isi gaseste componenta inapoi, prin nodurile de aceeasi culoare
+            vector<int> coada;
+            for (long long bloc = urmatorulBloc.fetch_add(64); bloc < nrRamase; bloc = urmatorulBloc.fetch_add(64)) {
+                for (long long i = bloc; i < min(bloc + 64, nrRamase); i++) {
+                    int radacina = ramase[i];
+                    if (marcaj[radacina].load(memory_order_relaxed) != radacina) {
+                        continue;
+                    }
+                    eticheta[radacina].store(radacina, memory_order_relaxed);
+                    coada.assign(1, radacina);
+                    for (size_t j = 0; j < coada.size(); j++) {
+                        for (const int *it = inceputIntrari(coada[j]); it != sfarsitIntrari(coada[j]); it++) {
+                            if (marcaj[*it].load(memory_order_relaxed) == radacina &&
+                                eticheta[*it].load(memory_order_relaxed) == 0) {
+                                eticheta[*it].store(radacina, memory_order_relaxed);
+                                coada.push_back(*it);
+                            }
+                        }
                     }
                 }
-                adaugareMuchie(nod, nodAdiacentCurent);
-                muchiiVizitate[make_pair(nod, nodAdiacentCurent)] = true;
-                muchiiVizitate[make_pair(nodAdiacentCurent, nod)] = true;
             }
+            bariera.asteptare();
+            for (long long i = inceput; i < sfarsit; i++) {
+                marcaj[ramase[i]].store(eticheta[ramase[i]].load(memory_order_relaxed) != 0 ? -1 : 0,
+                                        memory_order_relaxed);
+            }
+        });
+        if (!stabilizat) {
+            for (int nod: ramase) {
+                marcaj[nod].store(0, memory_order_relaxed);
+            }
+            break;
         }
+
+        vector<int> urmatoarele;
+        for (int nod: ramase) {
+            if (eticheta[nod].load(memory_order_relaxed) == 0) {
+                urmatoarele.push_back(nod);
+            }
+        }
+        progres = (long long) urmatoarele.size() * 10 <= nrRamase * 9;
+        ramase.swap(urmatoarele);
     }
-    return result;
+
+    // nodurile ramase sunt terminate cu Tarjan; restul grafului este ignorat (index = -1)
+    if (!ramase.empty()) {
+        VizitatorTarjan vizitator(nrNoduri);
+        for (int nod = 1; nod <= nrNoduri; nod++) {
+            if (eticheta[nod].load(memory_order_relaxed) != 0) {
+                vizitator.index[nod] = -1;
+            }
+        }
+        for (int nod: ramase) {
+            if (!vizitator.vizitat(nod)) {
+                parcurgereDFS(nod, vizitator);
+            }
+        }
+        for (int nod: ramase) {
+            eticheta[nod].store(vizitator.eticheta[nod], memory_order_relaxed);
+        }
+    }
+
+    // numerotarea componentelor in ordinea celui mai mic nod
+    componenta.assign(nrNoduri + 1, 0);
+    vector<int> indice(nrNoduri + 1, 0);
+    int nrComponente = 0;
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        int reprezentant = eticheta[nod].load(memory_order_relaxed);
+        if (indice[reprezentant] == 0) {
+            indice[reprezentant] = ++nrComponente;
+        }
+        componenta[nod] = indice[reprezentant];
+    }
+
+    // renumerotarea in ordine topologica, ca la componenteTareConexe: condensarea este aciclica, deci Kahn o sorteaza
+    Graf provizorie = condensare(componenta, nrComponente);
+    vector<int> ordine, nivel, ciclu;
+    provizorie.sortareTopologicaParalel(ordine, nivel, ciclu, nrFire);
+    vector<int> indiceTopologic(nrComponente + 1);
+    for (int i = 0; i < nrComponente; i++) {
+        indiceTopologic[ordine[i]] = i + 1;
+    }
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        componenta[nod] = indiceTopologic[componenta[nod]];
+    }
+    vector<pair<int, int>> arce;
+    arce.reserve(provizorie.numarMuchii());
+    for (int c = 1; c <= nrComponente; c++) {
+        for (const int *it = provizorie.inceputAdiacenta(c); it != provizorie.sfarsitAdiacenta(c); it++) {
+            arce.push_back({indiceTopologic[c], indiceTopologic[*it]});
+        }
+    }
+    return Graf(nrComponente, arce, true);
 }
 
 /*
- * O muchie [a,b] este muchie critica daca nu exista niciun drum de la descendentii lui b la a sau ascendentii sai
+ * Adauga in result nodurile atinse din nod, in post-ordine (un nod apare dupa toti succesorii sai)
+ * vizitate[x] = 1 cat timp x este pe drumul curent din DFS, 2 dupa ce a fost terminat
+ * parinte[x] = nodul din care a fost descoperit x
+ * Un arc catre un nod de pe drumul curent inchide un ciclu; primul astfel de ciclu este pus in ciclu
+ * (in ordinea arcelor), daca ciclu este inca gol
  */
-void
-Graf::MuchieCritica(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
-                    vector<vector<int>> &result) {
+void Graf::sortare_topologica(const int nod, vector<int> &vizitate, vector<int> &parinte, vector<int> &result,
+                              vector<int> &ciclu) {
+    struct Vizitator : VizitatorVector {
+        vector<int> &parinte, &result, &ciclu;
+
+        Vizitator(vector<int> &vizitate, vector<int> &parinte, vector<int> &result, vector<int> &ciclu)
+                : VizitatorVector(vizitate), parinte(parinte), result(result), ciclu(ciclu) {}
 
-    static int t = 0;
-    vizitate[nod] = 1; // vizitam nodul
-    t++;
-    low_time[nod] = t;
-    time[nod] = low_time[nod];
+        void intrare(const int nod, const int parinteNod) {
+            parinte[nod] = parinteNod;
+        }
 
-    // parcurgem fiecare nod adiacent nodului curent
-    for (int i = 1; i < matriceAdiacenta[nod].size(); i++) {
-        int nodAdiacentCurent = matriceAdiacenta[nod][i];
-        if (!vizitate[nodAdiacentCurent]) { // daca nu e vizitat
-            parent[nodAdiacentCurent] = nod; // tinem minte parintele
-            MuchieCritica(nodAdiacentCurent, time, low_time, parent,
-                          vizitate, result); // facem verificarea si pentru nodulAdiacentCurent
-            low_time[nod] = min(low_time[nod],
-                                low_time[nodAdiacentCurent]); // actualizam low_time[nod] daca nodAdiacentCurent are muchie cu un parinte al nodului sau cu nodul
-            if (low_time[nodAdiacentCurent] >
-                time[nod]) { // conditia ca muchiia [nod,nodAdiacentCuret] sa fie critica (sa aiba drum la nod sau ascendentii sai)
-//                cout << nod << " " << nodAdiacentCurent << '\n';
-                vector<int> pair;
-                pair.push_back(nod);
-                pair.push_back(nodAdiacentCurent);
-                result.push_back(pair);
+        void muchieInapoi(const int nod, const int vecin, long long) {
+            if (vizitate[vecin] == 1 && ciclu.empty()) {
+                for (int x = nod; x != vecin; x = parinte[x]) {
+                    ciclu.push_back(x);
+                }
+                ciclu.push_back(vecin);
+                reverse(ciclu.begin(), ciclu.end());
             }
-        } else if (nodAdiacentCurent != parent[nod]) {
-            low_time[nod] = min(low_time[nod], time[nodAdiacentCurent]);
         }
-    }
-}
 
-void
-Graf::dfs_pamant(const int nod, vector<int> &time, vector<int> &low_time, vector<int> &parent, vector<int> &vizitate,
-                 vector<int> &result) {
+        void iesire(const int nod, int) {
+            vizitate[nod] = 2;
+            result.push_back(nod);
+        }
+    } vizitator(vizitate, parinte, result, ciclu);
 
-    static int t = 0;
-    vizitate[nod] = 1; // vizitam nodul
-    t++;
-    low_time[nod] = t;
-    time[nod] = low_time[nod];
-    int ct = 0;
+    parcurgereDFS(nod, vizitator);
+}
 
-    // parcurgem fiecare nod adiacent nodului curent
-    for (int i = 1; i < matriceAdiacenta[nod].size(); i++) {
-        int nodAdiacentCurent = matriceAdiacenta[nod][i];
-        if (!vizitate[nodAdiacentCurent]) { // daca nu e vizitat
-            ct++;
-            parent[nodAdiacentCurent] = nod; // tinem minte parintele
-            dfs_pamant(nodAdiacentCurent, time, low_time, parent,
-                       vizitate, result); // facem verificarea si pentru nodulAdiacentCurent
-            low_time[nod] = min(low_time[nod],
-                                low_time[nodAdiacentCurent]); // actualizam low_time[nod] daca nodAdiacentCurent are muchie cu un parinte al nodului sau cu nodul
-            if (low_time[nodAdiacentCurent] >
-                time[nod]) { // conditia ca muchiia [nod,nodAdiacentCuret] sa fie critica (sa aiba drum la nod sau ascendentii sai)
-//                cout << nod << " " << nodAdiacentCurent << '\n';
-                result[i] = 1;
-            }
-        } else if (nodAdiacentCurent != parent[nod]) {
-            low_time[nod] = min(low_time[nod], time[nodAdiacentCurent]);
+/*
+ * Ca DFS_sortareTopologica(ciclu), dar rezultatul este si afisat in out: nodurile in ordine topologica pe o linie,
+ * sau "ciclu" urmat de nodurile unui ciclu daca graful nu este aciclic
+ */
+vector<int> Graf::DFS_sortareTopologica(ostream &out) {
+    vector<int> ciclu;
+    vector<int> result = DFS_sortareTopologica(ciclu);
+    if (!ciclu.empty()) {
+        out << "ciclu";
+        for (int nod: ciclu) {
+            out << ' ' << nod;
+        }
+    } else {
+        for (auto it = result.rbegin(); it != result.rend(); it++) {
+            out << (it == result.rbegin() ? "" : " ") << *it;
         }
     }
+    out << '\n';
+    return result;
+}
+
+vector<int> Graf::DFS_sortareTopologica() {
+    vector<int> ciclu;
+    return DFS_sortareTopologica(ciclu);
 }
 
 /*
- * Ia fiecare nod al grafului si apeleaza functia MuchiCritica
+ * Sortare topologica prin DFS: returneaza nodurile in post-ordine, deci ordinea topologica este cea inversa
+ * Daca graful are un ciclu, rezultatul este gol, iar ciclu contine nodurile unui ciclu, in ordinea arcelor
+ * (ultimul nod are arc catre primul); intr-un graf neorientat orice muchie formeaza un astfel de ciclu
  */
-vector<vector<int>> Graf::DFS_muchiiCritice() {
-    // time = vector in care tinem minte momentul in care un nod a fost vizitat
-    // low_time = vector in care tinem minte muchia vizitata cel mai devreme
-    // parent = vector care retine parintele nodurilor
-    vector<int> vizitate(nrNoduri + 1, 0), parent(nrNoduri + 1, -1), time(nrNoduri + 1), low_time(nrNoduri + 1);
-    vector<vector<int>> result;
+vector<int> Graf::DFS_sortareTopologica(vector<int> &ciclu) {
+    INSTR_FAZA("Graf::DFS_sortareTopologica");
+    vector<int> vizitate(nrNoduri + 1, 0), parinte(nrNoduri + 1, 0);
+    vector<int> result;
 
-    // parcurgem fiecare nod al grafului
+    ciclu.clear();
     for (int i = 1; i <= this->nrNoduri; i++) {
         if (!vizitate[i]) {
-            MuchieCritica(i, time, low_time, parent, vizitate, result);
+            sortare_topologica(i, vizitate, parinte, result, ciclu);
         }
     }
+    if (!ciclu.empty()) {
+        result.clear();
+    }
     return result;
 }
 
-void Graf::sortare_topologica(const int nod, vector<int> &vizitate, vector<int> &result) {
-    vizitate[nod] = 1;
-
-    // parcurgem fiecare nod adiacent nodului curent
-    for (int i = 1; i < matriceAdiacenta[nod].size(); i++) {
-        int nodCurentAdiacent = matriceAdiacenta[nod][i];
-        if (!vizitate[nodCurentAdiacent]) {
-            sortare_topologica(nodCurentAdiacent, vizitate, result);
-        }
+/*
+ * Sortare topologica paralela (Kahn), sincronizata pe niveluri ca distantaMinimaBFSParalel:
+ * nivelul 0 contine nodurile fara arce de intrare, iar un nod intra in nivelul k + 1 cand ultimul arc de intrare
+ * ramas (de la un nod din nivelul k) este eliminat; decrementarea gradului este atomica, deci exact un fir il gaseste
+ * la zero si il adauga in frontiera, fara alte revendicari
+ * ordine = nodurile in ordine topologica, nivel dupa nivel (doar cele sortate, daca exista un ciclu)
+ * nivel[nod] = nivelul nodului (lungimea celui mai lung drum care se termina in el), -1 daca nu a putut fi sortat
+ * ciclu = gol pentru un graf aciclic; altfel nodurile unui ciclu, in ordinea arcelor (ultimul are arc catre primul),
+ *         gasit mergand inapoi (pe transpus) printre nodurile nesortate: fiecare are un predecesor nesortat
+ * nrFire = numarul de fire de executie (0 -> numarul de nuclee)
+ * Returneaza numarul de niveluri, sau -1 daca graful are un ciclu
+ */
+int Graf::sortareTopologicaParalel(vector<int> &ordine, vector<int> &nivel, vector<int> &ciclu, int nrFire) {
+    INSTR_FAZA("Graf::sortareTopologicaParalel");
+    const long long marimeBloc = 64;
+    if (nrFire <= 0) {
+        nrFire = nrFireImplicit();
     }
+    nrFire = max(1, min(nrFire, nrNoduri / 1024 + 1));
+    constructieTranspus();
+
+    vector<atomic<int>> gradIntrare(nrNoduri + 1);
+    nivel.assign(nrNoduri + 1, -1);
+    ordine.assign(nrNoduri, 0);
+    atomic<long long> urmatorulBloc(0);
+    vector<vector<int>> buffere(nrFire);
+    BarieraFire bariera(nrFire);
+    long long nrSortate = 0;
+    int nrNiveluri = 0;
+
+    executieParalela(nrFire, [&](int fir) {
+        vector<int> &buffer = buffere[fir];
+        for (int nod = (int) (1 + (long long) nrNoduri * fir / nrFire);
+             nod < (int) (1 + (long long) nrNoduri * (fir + 1) / nrFire); nod++) {
+            gradIntrare[nod].store((int) (sfarsitIntrari(nod) - inceputIntrari(nod)), memory_order_relaxed);
+            if (gradIntrare[nod].load(memory_order_relaxed) == 0) {
+                nivel[nod] = 0;
+                buffer.push_back(nod);
+            }
+        }
 
-    result.push_back(nod);
-}
+        // frontiera nivelului curent este intervalul [inceput, sfarsit) din ordine; la fiecare pas bufferele sunt
+        // copiate la sfarsit (primul pas aduna nivelul 0, de aceea incepe cu frontiera goala)
+        long long inceput = 0, sfarsit = 0;
+        for (int nivelCurent = 0;; nivelCurent++) {
+            if (nivelCurent > 0) {
+                for (long long bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed);
+                     bloc < sfarsit; bloc = urmatorulBloc.fetch_add(marimeBloc, memory_order_relaxed)) {
+                    for (long long i = bloc; i < min(bloc + marimeBloc, sfarsit); i++) {
+                        int nod = ordine[i];
+                        for (const int *it = inceputAdiacenta(nod); it != sfarsitAdiacenta(nod); it++) {
+                            if (gradIntrare[*it].fetch_sub(1, memory_order_relaxed) == 1) {
+                                nivel[*it] = nivelCurent;
+                                buffer.push_back(*it);
+                            }
+                        }
+                    }
+                }
+            }
+            bariera.asteptare();
 
-vector<int> Graf::DFS_sortareTopologica(ostream &out) {
-    vector<int> vizitate(nrNoduri + 1, 0);
-    vector<int> result;
+            long long pozitie = sfarsit, sfarsitUrmator = sfarsit;
+            for (int i = 0; i < nrFire; i++) {
+                if (i < fir) {
+                    pozitie += (long long) buffere[i].size();
+                }
+                sfarsitUrmator += (long long) buffere[i].size();
+            }
+            if (fir == 0) {
+                urmatorulBloc.store(sfarsit, memory_order_relaxed);
+            }
+            copy(buffer.begin(), buffer.end(), ordine.begin() + pozitie);
+            bariera.asteptare();
+
+            buffer.clear();
+            inceput = sfarsit;
+            sfarsit = sfarsitUrmator;
+            if (inceput == sfarsit) {
+                if (fir == 0) {
+                    nrSortate = sfarsit;
+                    nrNiveluri = nivelCurent;
+                }
+                break;
+            }
+        }
+    });
+    ordine.resize(nrSortate);
 
-    for (int i = 1; i <= this->nrNoduri; i++) {
-        if (!vizitate[i]) {
-            sortare_topologica(i, vizitate, result);
+    ciclu.clear();
+    if (nrSortate == nrNoduri) {
+        return nrNiveluri;
+    }
+    // drumul inapoi printre nodurile nesortate se inchide intr-un ciclu la primul nod repetat
+    vector<int> pozitieDrum(nrNoduri + 1, -1), drum;
+    int nod = 1;
+    while (nivel[nod] != -1) {
+        nod++;
+    }
+    while (pozitieDrum[nod] == -1) {
+        pozitieDrum[nod] = (int) drum.size();
+        drum.push_back(nod);
+        const int *it = inceputIntrari(nod);
+        while (nivel[*it] != -1) {
+            it++;
         }
+        nod = *it;
     }
-    return result;
+    ciclu.assign(drum.rbegin(), drum.rend() - pozitieDrum[nod]);
+    return -1;
 }
 
 /*
@@ -517,26 +3851,37 @@ int Graf::disjoint(int cod, int x, int y, vector<int> &parinte, vector<int> &ran
     }
 }
 
-vector<int> Graf::dijkstra(vector<vector<pair<int, int>>> &matriceAdiacentaCosturi, int nodStart) {
+/*
+ * Distantele minime de la nodStart; intr-un graf fara costuri fiecare muchie are costul 1
+ */
+vector<int> Graf::dijkstra(int nodStart) {
+    INSTR_FAZA("Graf::dijkstra");
     vector<int> vizitate(nrNoduri + 1, 0), dist(nrNoduri + 1, INT_MAX);
     // heap in care retinem perechi de tipul (distanta,nod), unde distanta = distanta de la nodStart la nod
     priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
 
     dist[nodStart] = 0; // distanta de la nodStart la el insusi este 0
     pq.push({0, nodStart});
+    INSTR_CONTOR(HEAP_PUSH, 1);
     while (pq.size() > 0) {
         int nod = pq.top().second;
         pq.pop();
+        INSTR_CONTOR(HEAP_POP, 1);
         if (vizitate[nod] == 0) {
             vizitate[nod] = 1;
             // parcurgem nodurile adiacente nodului curent
-            for (auto it = matriceAdiacentaCosturi[nod].begin(); it != matriceAdiacentaCosturi[nod].end(); it++) {
-                int nodAdiacent = it->first;
-                int distanta = it->second; // distanta de la nodul curent la nodul adiacent
+            const int *vecini = inceputAdiacenta(nod), *costuri = inceputCosturi(nod);
+            long long nrVecini = sfarsitAdiacenta(nod) - vecini;
+            INSTR_CONTOR(NODURI_VIZITATE, 1);
+            INSTR_CONTOR(MUCHII_SCANATE, nrVecini);
+            for (long long k = 0; k < nrVecini; k++) {
+                int nodAdiacent = vecini[k];
+                int distanta = costuri ? costuri[k] : 1; // distanta de la nodul curent la nodul adiacent
                 // verificam daca distanta de la nodul curent la nodStart + distanta de la nodul curent la nodul adiacent este minima, caz in care o adaugam in heap
                 if (dist[nodAdiacent] > dist[nod] + distanta) {
                     dist[nodAdiacent] = dist[nod] + distanta;
                     pq.push({dist[nodAdiacent], nodAdiacent});
+                    INSTR_CONTOR(HEAP_PUSH, 1);
                 }
             }
         }
@@ -544,8 +3889,12 @@ vector<int> Graf::dijkstra(vector<vector<pair<int, int>>> &matriceAdiacentaCostu
     return dist;
 }
 
-vector<int> Graf::bellman_ford(vector<vector<pair<int, int>>> &matriceAdiacentaCosturi, int nodStart) {
-    vector<int> vizitate(nrNoduri + 1, 0), dist(nrNoduri + 1, INT_MAX), inCoada(nrNoduri, 0);
+/*
+ * Distantele minime de la nodStart; intr-un graf fara costuri fiecare muchie are costul 1
+ */
+vector<int> Graf::bellman_ford(int nodStart) {
+    INSTR_FAZA("Graf::bellman_ford");
+    vector<int> vizitate(nrNoduri + 1, 0), dist(nrNoduri + 1, INT_MAX), inCoada(nrNoduri + 1, 0);
     queue<int> q;
 
     q.push(nodStart); // punem primul nod in coada
@@ -559,9 +3908,13 @@ vector<int> Graf::bellman_ford(vector<vector<pair<int, int>>> &matriceAdiacentaC
         inCoada[nod] = 0;
 
         // Parcurgem nodurile adiacente nodului curent
-        for (auto it = matriceAdiacentaCosturi[nod].begin(); it != matriceAdiacentaCosturi[nod].end(); it++) {
-            int nodAdiacent = it->first;
-            int distanta = it->second;
+        const int *vecini = inceputAdiacenta(nod), *costuri = inceputCosturi(nod);
+        long long nrVecini = sfarsitAdiacenta(nod) - vecini;
+        INSTR_CONTOR(NODURI_VIZITATE, 1);
+        INSTR_CONTOR(MUCHII_SCANATE, nrVecini);
+        for (long long k = 0; k < nrVecini; k++) {
+            int nodAdiacent = vecini[k];
+            int distanta = costuri ? costuri[k] : 1;
             if (dist[nodAdiacent] > dist[nod] + distanta) {
                 dist[nodAdiacent] = dist[nod] + distanta;
 
@@ -574,7 +3927,7 @@ vector<int> Graf::bellman_ford(vector<vector<pair<int, int>>> &matriceAdiacentaC
                 // Daca nu este in coada il adaugam
                 if (inCoada[nodAdiacent] == 0) {
                     q.push(nodAdiacent);
-                    inCoada[nodStart] = 1;
+                    inCoada[nodAdiacent] = 1;
                 }
             }
         }
@@ -591,24 +3944,46 @@ vector<int> Graf::bellman_ford(vector<vector<pair<int, int>>> &matriceAdiacentaC
  * nodAdancimeMax = nodul la care adancimea era maxima
  */
 void Graf::DFS_darb(int nod, vector<int> &vizitate, int &adancime, int &adancimeMax, int &nodAdancimeMax) {
-    vizitate[nod] = 1;
-    for (int i = 1; i < matriceAdiacenta[nod].size(); i++) { // parcurgem nodurile adiacente nodului curent
-        if (vizitate[matriceAdiacenta[nod][i]] == 0) { // daca nu a fost vizitat
+    struct Vizitator : VizitatorVector {
+        int &adancime, &adancimeMax, &nodAdancimeMax;
+
+        Vizitator(vector<int> &vizitate, int &adancime, int &adancimeMax, int &nodAdancimeMax)
+                : VizitatorVector(vizitate), adancime(adancime), adancimeMax(adancimeMax),
+                  nodAdancimeMax(nodAdancimeMax) {}
+
+        void intrare(const int nod, const int parinte) {
+            if (parinte == 0) { // radacina ramane la adancimea primita
+                return;
+            }
             adancime += 1;
             if (adancime > adancimeMax) {
                 adancimeMax = adancime;
-                nodAdancimeMax = matriceAdiacenta[nod][i];
+                nodAdancimeMax = nod;
             }
-            DFS_darb(matriceAdiacenta[nod][i], vizitate, adancime, adancimeMax, nodAdancimeMax);
-            adancime -= 1;
         }
-    }
+
+        void iesire(int, const int parinte) {
+            if (parinte != 0) {
+                adancime -= 1;
+            }
+        }
+    } vizitator(vizitate, adancime, adancimeMax, nodAdancimeMax);
+
+    parcurgereDFS(nod, vizitator);
 }
 
-vector<int> Graf::Euler(vector<vector<pair<int, int>>> matriceAdiacentaNrMuchii, int nrMuchii) {
+/*
+ * Ciclu eulerian pornind din nodul 1, folosind id-urile muchiilor pentru a marca muchiile parcurse
+ * ramase[nod] = cate muchii din lista lui nod nu au fost inca luate in considerare (listele sunt parcurse de la final)
+ * Returneaza {-1} daca exista un nod cu grad impar
+ */
+vector<int> Graf::Euler() {
+    INSTR_FAZA("Graf::Euler");
+    vector<long long> ramase(this->nrNoduri + 1, 0);
     // verificam daca exista vreun nod cu grad impar
-    for (int i = 0; i <= this->nrNoduri; i++) {
-        if (matriceAdiacentaNrMuchii[i].size() % 2 == 1) {
+    for (int i = 1; i <= this->nrNoduri; i++) {
+        ramase[i] = sfarsitAdiacenta(i) - inceputAdiacenta(i);
+        if (ramase[i] % 2 == 1) {
             vector<int> sol;
             sol.push_back(-1);
             return sol;
@@ -617,15 +3992,15 @@ vector<int> Graf::Euler(vector<vector<pair<int, int>>> matriceAdiacentaNrMuchii,
 
     vector<int> sol;
     stack<int> stack;
-    vector<int> vizitate(nrMuchii + 1, 0);
+    vector<int> vizitate(this->nrMuchii + 1, 0);
     int nod;
     stack.push(1);
     while (!stack.empty()) {
         nod = stack.top();
-        if (!matriceAdiacentaNrMuchii[nod].empty()) { // daca exista noduri adiacente
-            int nodAdiacent = matriceAdiacentaNrMuchii[nod].back().first;
-            int indexMuchie = matriceAdiacentaNrMuchii[nod].back().second;
-            matriceAdiacentaNrMuchii[nod].pop_back();
+        if (ramase[nod] > 0) { // daca exista noduri adiacente
+            ramase[nod]--;
+            int nodAdiacent = inceputAdiacenta(nod)[ramase[nod]];
+            int indexMuchie = inceputIdMuchii(nod)[ramase[nod]];
             if (vizitate[indexMuchie] == 0) { // daca muchia nu a fost vizitate
                 // o vizitam si adaugam nodul adiacent in stack
                 vizitate[indexMuchie] = 1;
@@ -645,7 +4020,26 @@ struct compare_vectors_apm {
     }
 };
 
+/*
+ * Lista muchiilor grafului sub forma {x, y, cost}, in formatul primit de APM (costul este 0 daca graful nu are costuri)
+ * Intr-un graf neorientat fiecare muchie apare o singura data; buclele nu sunt incluse
+ */
+vector<vector<int>> Graf::muchiiCuCosturi() {
+    vector<vector<int>> muchii;
+    for (int nod = 1; nod <= nrNoduri; nod++) {
+        const int *vecini = inceputAdiacenta(nod);
+        long long nrVecini = sfarsitAdiacenta(nod) - vecini;
+        for (long long k = 0; k < nrVecini; k++) {
+            if (esteOrientat ? vecini[k] != nod : nod < vecini[k]) {
+                muchii.push_back({nod, vecini[k], areCosturi ? inceputCosturi(nod)[k] : 0});
+            }
+        }
+    }
+    return muchii;
+}
+
 vector<vector<int>> Graf::APM(vector<vector<int>> muchii) {
+    INSTR_FAZA("Graf::APM");
     // sortare muchii
 //    for (int i = 0; i < muchii.size() - 1; i++) {
 //        for (int j = i + 1; j < muchii.size(); j++) {
@@ -664,8 +4058,8 @@ vector<vector<int>> Graf::APM(vector<vector<int>> muchii) {
 
     vector<vector<int>> sol;
     int costMin = 0;
-    // cat timp avem mai putin de nrNoduri - 1 muchii selectate
-    while (sol.size() < this->nrNoduri - 1) {
+    // cat timp avem mai putin de nrNoduri - 1 muchii selectate (si mai sunt muchii, daca graful nu este conex)
+    while ((int) sol.size() + 1 < this->nrNoduri && !muchii.empty()) {
         int x = muchii.back()[0];
         int y = muchii.back()[1];
         int cost = muchii.back()[2];
@@ -686,7 +4080,12 @@ vector<vector<int>> Graf::APM(vector<vector<int>> muchii) {
     return sol;
 }
 
-int Graf::hamilton(vector<vector<pair<int, int>>> matriceAdiacentaCosturi) {
+/*
+ * Costul minim al unui ciclu hamiltonian, folosind costurile din graf
+ * In matricea de costuri nodul nod al grafului corespunde bitului nod - 1
+ */
+int Graf::hamilton() {
+    INSTR_FAZA("Graf::hamilton");
     int put = 1 << this->nrNoduri;
     int matriceCosturi[put][this->nrNoduri]; // initializare matrice
 
@@ -700,87 +4099,281 @@ int Graf::hamilton(vector<vector<pair<int, int>>> matriceAdiacentaCosturi) {
     for (int i = 0; i < put; i++) {
         for (int j = 0; j < this->nrNoduri; j++) {
             if (i & (1 << j)) {
-                for (int k = 0; k < matriceAdiacentaCosturi[j].size(); k++) {
-                    if (i & (1 << matriceAdiacentaCosturi[j][k].first)) {
+                const int *vecini = inceputAdiacenta(j + 1), *costuri = inceputCosturi(j + 1);
+                long long nrVecini = sfarsitAdiacenta(j + 1) - vecini;
+                for (long long k = 0; k < nrVecini; k++) {
+                    int vecin = vecini[k] - 1;
+                    if (i & (1 << vecin)) {
                         matriceCosturi[i][j] = min(matriceCosturi[i][j],
-                                                   matriceCosturi[i ^ (1 << j)][matriceAdiacentaCosturi[j][k].first] +
-                                                   matriceAdiacentaCosturi[j][k].second);
+                                                   matriceCosturi[i ^ (1 << j)][vecin] + (costuri ? costuri[k] : 1));
                     }
                 }
             }
         }
     }
 
-    int sol = 0x3f3f3f3f;
-    for (int i = 0; i < matriceAdiacentaCosturi[0].size(); i++) {
-        sol = min(sol,
-                  matriceCosturi[put - 1][matriceAdiacentaCosturi[0][i].first] + matriceAdiacentaCosturi[0][i].second);
+    int sol = 0x3f3f3f3f;
+    const int *vecini = inceputAdiacenta(1), *costuri = inceputCosturi(1);
+    for (long long i = 0; i < sfarsitAdiacenta(1) - vecini; i++) {
+        sol = min(sol, matriceCosturi[put - 1][vecini[i] - 1] + (costuri ? costuri[i] : 1));
+    }
+    return sol;
+}
+
+int Graf::BFS_amici2(int start, vector<vector<int>> &matriceAdiacenta2) {
+    INSTR_FAZA("Graf::BFS_amici2");
+    int maxi = 0;
+    // spatiu.valoare[nod] = nivelul nodului (1 pentru start), iar spatiu.lista este coada
+    SpatiuLucru &spatiu = SpatiuLucru::alFirului();
+    spatiu.pregatire(this->nrNoduri);
+    vector<int> &nivel = spatiu.valoare, &queue = spatiu.lista;
+    queue.push_back(start);
+    spatiu.vizitare(start);
+    nivel[start] = 1;
+
+    for (size_t i = 0; i < queue.size(); i++) {
+        int nodUrm = queue[i];
+        INSTR_CONTOR(NODURI_VIZITATE, 1);
+        INSTR_CONTOR(MUCHII_SCANATE, matriceAdiacenta2[nodUrm].size());
+        for (int j = 0; j < matriceAdiacenta2[nodUrm].size(); j++) { // parcurgem fiecare nod adiacent al nodului curent
+            int nod = matriceAdiacenta2[nodUrm][j];
+            // Daca nu a fost vizitat inca
+            if (!spatiu.vizitat(nod)) {
+                spatiu.vizitare(nod);
+                nivel[nod] = nivel[nodUrm] + 1;
+                queue.push_back(nod); // Il adaugam in coada pentru a fi vizitat
+                maxi = max(maxi, nivel[nodUrm]);
+            }
+        }
+    }
+
+    int sol = 0;
+    for (int i = 1; i <= maxi; i *= 2) {
+        sol++;
+    }
+
+    // Returnam maximul
+    return sol;
+}
+
+/*
+ * Graf implicit pe o grila linii x coloane: muchiile nu sunt memorate, vecinii unei celule sunt cele 4 celule alaturate
+ * Fiecare celula ocupa un octet (LIBER sau ZID), iar grila este bordata cu cate un rand/o coloana de ziduri pe fiecare
+ * latura, deci vecinii celulei de indice k sunt mereu k - 1, k + 1, k - latime, k + latime, fara verificari de margini
+ * Celulele sunt identificate prin indicele lor in vectorul liniarizat (index(linie, coloana), numerotate de la 0);
+ * vectorii intorsi de parcurgeri sunt indexati la fel
+ * Memorie: grila ocupa 1 octet pe celula, iar fiecare parcurgere mai aloca un int pe celula pentru rezultat
+ * (distanta sau eticheta); frontiera BFS tine doar nivelul curent si cel urmator, iar union-find-ul etichetarii
+ * doua int-uri pe secventa de celule libere de pe o linie. Masurat (RSS maxim, 25% ziduri aleatoare):
+ * distanteBFS ~4.9 octeti pe celula (1.96 GB pentru 4 * 10^8 celule), etichetareComponente ~6.5 octeti pe celula,
+ * deci o grila de 10^9 celule cere ~5-7 GB
+ */
+class GrafGrila {
+    int linii = 0, coloane = 0;
+    long long latime = 0; // coloane + 2, distanta dintre doua celule aflate una sub alta
+    vector<unsigned char> celule;
+
+public:
+    static const unsigned char LIBER = 0;
+    static const unsigned char ZID = 1;
+
+    GrafGrila(int linii, int coloane);
+
+    long long index(const int linie, const int coloana) const {
+        return (linie + 1) * latime + coloana + 1;
+    }
+
+    int linie(const long long index) const {
+        return (int) (index / latime) - 1;
+    }
+
+    int coloana(const long long index) const {
+        return (int) (index % latime) - 1;
+    }
+
+    // numarul de celule, inclusiv bordura (dimensiunea vectorilor intorsi de parcurgeri)
+    long long numarCelule() const {
+        return (long long) celule.size();
+    }
+
+    void setareCelula(const int linie, const int coloana, const unsigned char valoare) {
+        celule[index(linie, coloana)] = valoare;
+    }
+
+    bool esteLibera(const long long index) const {
+        return celule[index] == LIBER;
+    }
+
+    vector<int> distanteBFS(long long start);
+
+    vector<int> distanteMultiSursa(const vector<long long> &surse);
+
+    int etichetareComponente(vector<int> &eticheta);
+};
+
+const unsigned char GrafGrila::LIBER;
+const unsigned char GrafGrila::ZID;
+
+/*
+ * Construieste o grila linii x coloane cu toate celulele libere, inconjurata de ziduri
+ */
+GrafGrila::GrafGrila(const int linii, const int coloane) {
+    this->linii = linii;
+    this->coloane = coloane;
+    this->latime = coloane + 2;
+    celule.assign((linii + 2) * latime, ZID);
+    for (int i = 0; i < linii; i++) {
+        fill(celule.begin() + index(i, 0), celule.begin() + index(i, 0) + coloane, LIBER);
+    }
+}
+
+vector<int> GrafGrila::distanteBFS(const long long start) {
+    return distanteMultiSursa(vector<long long>(1, start));
+}
+
+/*
+ * BFS pornit simultan din toate celulele din surse (ziduri ignorate), nivel cu nivel: in loc de o coada cu toate
+ * celulele se pastreaza doar frontiera curenta si cea urmatoare, de obicei de ordinul liniilor + coloanelor
+ * Returneaza distanta fiecarei celule pana la cea mai apropiata sursa (-1 pentru ziduri si celulele inaccesibile)
+ * Complexitate O(linii * coloane)
+ */
+vector<int> GrafGrila::distanteMultiSursa(const vector<long long> &surse) {
+    INSTR_FAZA("GrafGrila::distanteMultiSursa");
+    vector<int> distanta(celule.size(), -1);
+    vector<long long> frontiera, urmatoarea;
+    for (long long sursa: surse) {
+        if (celule[sursa] == LIBER && distanta[sursa] == -1) {
+            distanta[sursa] = 0;
+            frontiera.push_back(sursa);
+        }
+    }
+
+    const long long deplasari[4] = {-latime, -1, 1, latime};
+    for (int distantaVecin = 1; !frontiera.empty(); distantaVecin++) {
+        urmatoarea.clear();
+        for (long long celula: frontiera) {
+            INSTR_CONTOR(NODURI_VIZITATE, 1);
+            INSTR_CONTOR(MUCHII_SCANATE, 4);
+            for (long long deplasare: deplasari) {
+                long long vecin = celula + deplasare;
+                // bordura de ziduri garanteaza ca vecin este mereu in interiorul vectorului
+                if (celule[vecin] == LIBER && distanta[vecin] == -1) {
+                    distanta[vecin] = distantaVecin;
+                    urmatoarea.push_back(vecin);
+                }
+            }
+        }
+        frontiera.swap(urmatoarea);
     }
-    return sol;
+    return distanta;
 }
 
-int Graf::BFS_amici2(int start, vector<vector<int>> &matriceAdiacenta2) {
-    int maxi = 0;
-    vector<int> vizitate(this->nrNoduri + 1, 0);
-
-    // Queue in care salvam elementele care trebuiesc vizitate. Cand se goleste, nu mai avem nimic de vizitat
-    queue<int> queue;
-    queue.push(start);
-    vizitate[start] = 1;
-
-    while (!queue.empty()) {
-        int nodUrm = queue.front();
-        queue.pop();
-        for (int i = 0; i < matriceAdiacenta2[nodUrm].size(); i++) { // parcurgem fiecare nod adiacent al nodului curent
-            int nod = matriceAdiacenta2[nodUrm][i];
-            // Daca nu a fost vizitat inca
-            if (vizitate[nod] == 0) {
-                vizitate[nod] = vizitate[nodUrm] + 1;
-                queue.push(nod); // Il adaugam in coada pentru a fi vizitat
-                maxi = max(maxi, vizitate[nodUrm]);
+/*
+ * Etichetarea componentelor conexe ale celulelor libere, linie cu linie:
+ * fiecare secventa continua de celule libere de pe o linie primeste o eticheta provizorie, care este reunita
+ * (union-find) cu etichetele secventelor de pe linia de deasupra pe care le atinge. La a doua trecere,
+ * fiecare eticheta provizorie este inlocuita cu numarul final al componentei ei.
+ * eticheta = la final, eticheta[celula] = componenta celulei (1, 2, ...), 0 pentru ziduri
+ * Returneaza numarul de componente
+ */
+int GrafGrila::etichetareComponente(vector<int> &eticheta) {
+    INSTR_FAZA("GrafGrila::etichetareComponente");
+    eticheta.assign(celule.size(), 0);
+    vector<int> parinte(1, 0); // eticheta 0 este rezervata zidurilor
+
+    auto radacina = [&](int x) {
+        while (parinte[x] != x) {
+            parinte[x] = parinte[parinte[x]];
+            x = parinte[x];
+        }
+        return x;
+    };
+
+    for (int i = 0; i < linii; i++) {
+        long long celula = index(i, 0), sfarsitLinie = celula + coloane;
+        while (celula < sfarsitLinie) {
+            if (celule[celula] != LIBER) {
+                celula++;
+                continue;
+            }
+            int secventa = (int) parinte.size();
+            parinte.push_back(secventa);
+            int deasupraAnterior = 0;
+            for (; celula < sfarsitLinie && celule[celula] == LIBER; celula++) {
+                eticheta[celula] = secventa;
+                int deasupra = eticheta[celula - latime];
+                if (deasupra != 0 && deasupra != deasupraAnterior) {
+                    int x = radacina(deasupra), y = radacina(secventa);
+                    if (x != y) {
+                        parinte[max(x, y)] = min(x, y);
+                    }
+                }
+                deasupraAnterior = deasupra;
             }
         }
     }
 
-    int sol = 0;
-    for (int i = 1; i <= maxi; i *= 2) {
-        sol++;
+    // numerotam componentele in ordinea primei lor celule
+    vector<int> componenta(parinte.size(), 0);
+    int nrComponente = 0;
+    for (int secventa = 1; secventa < (int) parinte.size(); secventa++) {
+        int r = radacina(secventa);
+        if (componenta[r] == 0) {
+            componenta[r] = ++nrComponente;
+        }
+        componenta[secventa] = componenta[r];
     }
-
-    // Returnam maximul
-    return sol;
+    for (int i = 0; i < linii; i++) {
+        for (long long celula = index(i, 0); celula < index(i, 0) + coloane; celula++) {
+            eticheta[celula] = componenta[eticheta[celula]];
+        }
+    }
+    return nrComponente;
 }
 
 /* -------------------------------------------------------------- */
 
 void infoarena_bfs() {
-    ifstream f("bfs.in");
-    ofstream g("bfs.out");
+    INSTR_ETAPE("infoarena_bfs"); // declarat primul ca etapa de afisare sa includa golirea bufferului
+    INSTR_ETAPA("citire");
+    CititorRapid f("bfs.in");
+    ScriitorRapid g("bfs.out");
 
     int N, M, S;
     f >> N >> M >> S;
     Graf graf(N, true);
     graf.citireGraf(f, M);
-    vector<int> distanta = graf.distantaMinimaBFS(g, S);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
+    vector<int> distanta = graf.distantaMinimaBFS(S);
+    INSTR_ETAPA("afisare");
     for (int i = 1; i <= N; i++) {
         g << distanta[i] << " ";
     }
 }
 
 void infoarena_dfs() {
-    ifstream f("dfs.in");
-    ofstream g("dfs.out");
+    INSTR_ETAPE("infoarena_dfs");
+    INSTR_ETAPA("citire");
+    CititorRapid f("dfs.in");
+    ScriitorRapid g("dfs.out");
 
     int N, M, S;
     f >> N >> M;
     Graf graf(N, false);
     graf.citireGraf(f, M);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
 //    map<int,bool> vizitate;
-    g << graf.componenteConexe();
+    INSTR_ETAPA("algoritm");
+    int nrComponente = graf.componenteConexe();
+    INSTR_ETAPA("afisare");
+    g << nrComponente;
 }
 
 void leetcode_CriticalConnections_neeficient() {
-    ifstream f("dfs.in");
+    CititorRapid f("dfs.in");
     int n, nrMuchii;
     f >> n;
     f >> nrMuchii;
@@ -790,27 +4383,35 @@ void leetcode_CriticalConnections_neeficient() {
 }
 
 void leetcode_CriticalConnections() {
-    ifstream f("dfs.in");
+    CititorRapid f("dfs.in");
     int n, nrMuchii;
     f >> n;
     f >> nrMuchii;
     Graf graf(n, false);
     graf.citireGraf(f, nrMuchii);
+    graf.inghetare();
     vector<vector<int>> result = graf.DFS_muchiiCritice();
+    ScriitorRapid out(stdout);
     for (int i = 0; i < result.size(); i++) {
-        cout << result[i][0] << " " << result[i][1] << '\n';
+        out << result[i][0] << " " << result[i][1] << '\n';
     }
 }
 
 void infoarena_sortareTopologica() {
-    ifstream f("sortaret.in");
-    ofstream g("sortaret.out");
+    INSTR_ETAPE("infoarena_sortareTopologica");
+    INSTR_ETAPA("citire");
+    CititorRapid f("sortaret.in");
+    ScriitorRapid g("sortaret.out");
 
     int N, M;
     f >> N >> M;
     Graf graf(N, true);
     graf.citireGraf(f, M);
-    vector<int> result = graf.DFS_sortareTopologica(g);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
+    vector<int> result = graf.DFS_sortareTopologica();
+    INSTR_ETAPA("afisare");
 
     for (int i = result.size() - 1; i >= 0; i--) {
         g << result[i] << " ";
@@ -818,44 +4419,54 @@ void infoarena_sortareTopologica() {
 }
 
 void infoarena_disjoint() {
-    ifstream f("disjoint.in");
-    ofstream g("disjoint.out");
+    INSTR_ETAPE("infoarena_disjoint");
+    INSTR_ETAPA("citire");
+    CititorRapid f("disjoint.in");
+    ScriitorRapid g("disjoint.out");
 
     int n, m;
     f >> n >> m;
 
+    INSTR_ETAPA("constructie");
     Graf graf;
     vector<int> parinte(n + 1), rang(n + 1, 1); // initial fiecare arbore are rangul 1, avand doar un nod
     for (int i = 1; i <= n; i++) {
         parinte[i] = i; // initial fiecare nod este radacina
     }
 
+    // operatiile sunt citite si raspunsurile scrise pe rand, asa ca etapa algoritm le include pe amandoua;
+    // etapa afisare ramane doar golirea bufferului
+    INSTR_ETAPA("algoritm");
     for (int i = 0; i < m; i++) {
         int cod, x, y;
         f >> cod >> x >> y;
         int result = graf.disjoint(cod, x, y, parinte, rang);
-        if (result == 1) {
+        if (g.esteBinar() && (result == 1 || result == 0)) {
+            g << result; // 1 pentru DA, 0 pentru NU
+        } else if (result == 1) {
             g << "DA" << '\n';
         } else if (result == 0) {
             g << "NU" << '\n';
         }
     }
+    INSTR_ETAPA("afisare");
 }
 
 void infoarena_dijkstra() {
-    ifstream f("dijkstra.in");
-    ofstream g("dijkstra.out");
+    INSTR_ETAPE("infoarena_dijkstra");
+    INSTR_ETAPA("citire");
+    CititorRapid f("dijkstra.in");
+    ScriitorRapid g("dijkstra.out");
 
     int n, m, nodStart = 1;
     f >> n >> m;
-    vector<vector<pair<int, int>>> matriceAdiacentaCosturi(m); // matrice de adiacenta care retine si costul unei muchii
-    int a, b, c;
-    for (int i = 0; i < m; i++) {
-        f >> a >> b >> c;
-        matriceAdiacentaCosturi[a].push_back(make_pair(b, c));
-    }
     Graf graf(n, true);
-    vector<int> dist = graf.dijkstra(matriceAdiacentaCosturi, nodStart);
+    graf.citireGrafCosturi(f, m);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
+    vector<int> dist = graf.dijkstra(nodStart);
+    INSTR_ETAPA("afisare");
     for (int i = 1; i <= n; i++) {
         if (i != nodStart) {
             if (dist[i] != INT_MAX) {
@@ -868,21 +4479,26 @@ void infoarena_dijkstra() {
 }
 
 void infoarena_bellman_ford() {
-    ifstream f("sortaret.in");
-    ofstream g("sortaret.out");
+    INSTR_ETAPE("infoarena_bellman_ford");
+    INSTR_ETAPA("citire");
+    CititorRapid f("sortaret.in");
+    ScriitorRapid g("sortaret.out");
 
     int n, m, nodStart = 1;
     f >> n >> m;
     Graf graf(n, true);
-    vector<vector<pair<int, int>>> matriceAdiacentaCosturi(m); // matrice de adiacenta care retine si costul unui drum
-    int a, b, c;
-    for (int i = 0; i < m; i++) {
-        f >> a >> b >> c;
-        matriceAdiacentaCosturi[a].push_back(make_pair(b, c));
-    }
-    vector<int> dist = graf.bellman_ford(matriceAdiacentaCosturi, nodStart);
+    graf.citireGrafCosturi(f, m);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
+    vector<int> dist = graf.bellman_ford(nodStart);
+    INSTR_ETAPA("afisare");
     if (dist.empty()) {
-        g << "Ciclu negativ!";
+        if (g.esteBinar()) {
+            g << INT_MIN; // nicio distanta nu poate fi INT_MIN, deci un singur INT_MIN marcheaza ciclul negativ
+        } else {
+            g << "Ciclu negativ!";
+        }
         return;
     }
     for (int i = 1; i <= n; i++) {
@@ -897,87 +4513,36 @@ void infoarena_bellman_ford() {
 }
 
 void infoarena_muzeu() {
-    ifstream f("muzeu.in");
-    ofstream g("muzeu.out");
+    INSTR_ETAPE("infoarena_muzeu");
+    INSTR_ETAPA("citire");
+    CititorRapid f("muzeu.in");
+    ScriitorRapid g("muzeu.out");
     int n;
     f >> n;
-    queue<pair<int, int>> queue;
-    int matrice[n][n];
-    int vizitate[n][n];
+    GrafGrila grila(n, n);
+    vector<long long> paznici;
 
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
             char x;
             f >> x;
-
-            vizitate[i][j] = 0;
             if (x == '#') {
-                matrice[i][j] = -2;
+                grila.setareCelula(i, j, GrafGrila::ZID);
             } else if (x == 'P') {
-                matrice[i][j] = 0;
-                queue.push(make_pair(i, j)); // Initial punem in queue toti paznicii
-            } else {
-                matrice[i][j] = -1; // Initial marcam toate camere ca nevizitabile
+                paznici.push_back(grila.index(i, j)); // Initial punem in coada toti paznicii
             }
         }
     }
 
-    // Parcurgem queue-ul de paznici
-    // De la fiecare paznic merge in toate directiile(sus, jos, stanga, dreapta) si elementul vizitat il adaugam in queue
-    while (!queue.empty()) {
-        int i = queue.front().first, j = queue.front().second, linie, coloana;
-        queue.pop();
-        vizitate[i][j] = 1;
-
-        // Sus - scadem 1 din linie
-        linie = i - 1;
-        coloana = j;
-        if (linie >= 0 && vizitate[linie][coloana] == 0) {
-            if (matrice[linie][coloana] != -2 && matrice[linie][coloana] != 0) {
-                vizitate[linie][coloana] = 1;
-                queue.push(make_pair(linie, coloana));
-                matrice[linie][coloana] = matrice[i][j] + 1;
-            }
-        }
-
-        // Jos - adunam 1 la linie
-        linie = i + 1;
-        coloana = j;
-        if (linie < n && vizitate[linie][coloana] == 0) {
-            if (matrice[linie][coloana] != -2 && matrice[linie][coloana] != 0) {
-                vizitate[linie][coloana] = 1;
-                queue.push(make_pair(linie, coloana));
-                matrice[linie][coloana] = matrice[i][j] + 1;
-            }
-        }
-
-        // Stanga - scadem 1 din coloana
-        linie = i;
-        coloana = j - 1;
-        if (coloana >= 0 && vizitate[linie][coloana] == 0) {
-            if (matrice[linie][coloana] != -2 && matrice[linie][coloana] != 0) {
-                vizitate[linie][coloana] = 1;
-                queue.push(make_pair(linie, coloana));
-                matrice[linie][coloana] = matrice[i][j] + 1;
-            }
-        }
-
-        // Dreapta - adunam 1 la coloana
-        linie = i;
-        coloana = j + 1;
-        if (coloana < n && vizitate[linie][coloana] == 0) {
-            if (matrice[linie][coloana] != -2 && matrice[linie][coloana] != 0) {
-                vizitate[linie][coloana] = 1;
-                queue.push(make_pair(linie, coloana));
-                matrice[linie][coloana] = matrice[i][j] + 1;
-            }
-        }
-    }
+    INSTR_ETAPA("algoritm");
+    vector<int> distanta = grila.distanteMultiSursa(paznici);
 
-    // Afisare
+    // Afisare: -2 pentru pereti, -1 pentru camerele in care nu poate ajunge niciun paznic
+    INSTR_ETAPA("afisare");
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
-            g << matrice[i][j] << ' ';
+            long long celula = grila.index(i, j);
+            g << (grila.esteLibera(celula) ? distanta[celula] : -2) << ' ';
         }
         g << '\n';
     }
@@ -989,12 +4554,17 @@ void infoarena_muzeu() {
  * calculeaza diametrul arborelui (distanta maxima dintre 2 frunze) si o afiseaza in fisier
  */
 void infoarena_darb() {
-    ifstream f("darb.in");
-    ofstream g("darb.out");
+    INSTR_ETAPE("infoarena_darb");
+    INSTR_ETAPA("citire");
+    CititorRapid f("darb.in");
+    ScriitorRapid g("darb.out");
     int n;
     f >> n;
     Graf graf(n, false);
     graf.citireGraf(f, n - 1);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
 
     // calculam distanta de la radacina la cel mai indepartat nod si salvam acest nod
     vector<int> vizitate(n + 1, 0);
@@ -1007,41 +4577,54 @@ void infoarena_darb() {
     adancime = 0;
     graf.DFS_darb(startDfs2, vizitate2, adancime, adancimeMax, nodAdancimeMax);
 
+    INSTR_ETAPA("afisare");
     g << adancimeMax + 1;
 }
 
 /*
+ * Roy-Floyd pe o matrice de costuri n x n memorata liniarizat (elementul (i, j) pe pozitia i * n + j)
+ * Un cost 0 intre noduri diferite inseamna ca nu exista drum; la final matricea contine costurile minime
  * O(n^3)
  */
-void infoarena_royfloyd() {
-    ifstream f("royfloyd.in");
-    ofstream g("royfloyd.out");
-    int n;
-    f >> n;
-    int matriceCosturi[n + 1][n + 1];
-
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            int cost;
-            f >> cost;
-            matriceCosturi[i][j] = cost;
-        }
-    }
-
+void royFloyd(const int n, vector<int> &matriceCosturi) {
+    INSTR_FAZA("royFloyd");
     for (int x = 0; x < n; x++) {
+        const int *linieX = &matriceCosturi[x * n];
         for (int i = 0; i < n; i++) {
+            int *linieI = &matriceCosturi[i * n];
+            int costIX = linieI[x];
+            if (costIX == 0) {
+                continue;
+            }
             for (int j = 0; j < n; j++) {
-                int val = matriceCosturi[i][x] + matriceCosturi[x][j];
-                if ((matriceCosturi[i][j] > val || (matriceCosturi[i][j] == 0 && i != j)) &&
-                    matriceCosturi[i][x] != 0 && matriceCosturi[x][j] != 0)
-                    matriceCosturi[i][j] = val;
+                int val = costIX + linieX[j];
+                if ((linieI[j] > val || (linieI[j] == 0 && i != j)) && linieX[j] != 0)
+                    linieI[j] = val;
             }
         }
     }
+}
+
+void infoarena_royfloyd() {
+    INSTR_ETAPE("infoarena_royfloyd");
+    INSTR_ETAPA("citire");
+    CititorRapid f("royfloyd.in");
+    ScriitorRapid g("royfloyd.out");
+    int n;
+    f >> n;
+    vector<int> matriceCosturi(n * n);
+
+    for (int i = 0; i < n * n; i++) {
+        f >> matriceCosturi[i];
+    }
+
+    INSTR_ETAPA("algoritm");
+    royFloyd(n, matriceCosturi);
+    INSTR_ETAPA("afisare");
 
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
-            g << matriceCosturi[i][j] << " ";
+            g << matriceCosturi[i * n + j] << " ";
         }
         g << '\n';
     }
@@ -1089,37 +4672,33 @@ void havel_hakimi(vector<int> grade) {
 }
 
 void infoarena_max_flow() {
-    ifstream f("maxflow.in");
-    ofstream g("maxflow.out");
+    INSTR_ETAPE("infoarena_max_flow");
+    INSTR_ETAPA("citire");
+    CititorRapid f("maxflow.in");
+    ScriitorRapid g("maxflow.out");
 
     int n, m;
     f >> n >> m;
-    vector<vector<pair<int, int>>> matriceAdiacentaCosturi(m); // matrice de adiacenta care retine si costul unei muchii
-    int a, b, c;
-    for (int i = 0; i < m; i++) {
-        f >> a >> b >> c;
-        matriceAdiacentaCosturi[a].push_back(make_pair(b, c));
-    }
     Graf graf(n, true);
+    graf.citireGrafCosturi(f, m);
 }
 
 void infoarena_ciclu_eulerian() {
-    ifstream f("ciclueuler.in");
-    ofstream g("ciclueuler.out");
+    INSTR_ETAPE("infoarena_ciclu_eulerian");
+    INSTR_ETAPA("citire");
+    CititorRapid f("ciclueuler.in");
+    ScriitorRapid g("ciclueuler.out");
 
     int N, M;
     f >> N >> M;
     Graf graf(N, false);
-    vector<vector<pair<int, int>>> matriceAdiacentaNrMuchii(N + 1);
-    for (int i = 0; i < M; i++) {
-        int x, y;
-        f >> x >> y;
-        // adaugam si indexul muchiei pentru a marca muchiile vizitate
-        matriceAdiacentaNrMuchii[x].push_back(make_pair(y, i));
-        matriceAdiacentaNrMuchii[y].push_back(make_pair(x, i));
-    }
+    graf.citireGraf(f, M); // fiecare muchie primeste un id, folosit pentru a marca muchiile vizitate
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
 
-    vector<int> sol = graf.Euler(matriceAdiacentaNrMuchii, M);
+    INSTR_ETAPA("algoritm");
+    vector<int> sol = graf.Euler();
+    INSTR_ETAPA("afisare");
 
     // daca avem un singur nod in solutie, respectiv -1
     if (sol.size() == 1 && sol[0] == -1) {
@@ -1132,13 +4711,14 @@ void infoarena_ciclu_eulerian() {
 }
 
 void infoarena_apm() {
-    ifstream f("apm.in");
-    ofstream g("apm.out");
+    INSTR_ETAPE("infoarena_apm");
+    INSTR_ETAPA("citire");
+    CititorRapid f("apm.in");
+    ScriitorRapid g("apm.out");
 
     int n, m;
     f >> n >> m;
     Graf graf(n, false);
-    vector<vector<pair<int, int>>> matriceAdiacentaCosturi(m); // matrice de adiacenta care retine si costul unui drum
     vector<vector<int>> muchii;
     int a, b, c;
     for (int i = 0; i < m; i++) {
@@ -1146,7 +4726,9 @@ void infoarena_apm() {
         muchii.push_back({a, b, c});
     }
 
+    INSTR_ETAPA("algoritm");
     vector<vector<int>> sol = graf.APM(muchii);
+    INSTR_ETAPA("afisare");
     g << sol.back()[0] << '\n';
     g << sol.size() - 1 << '\n';
     for (int i = 0; i < sol.size() - 1; i++) {
@@ -1155,57 +4737,78 @@ void infoarena_apm() {
 }
 
 void infoarena_hamilton() {
-    ifstream f("hamilton.in");
-    ofstream g("hamilton.out");
+    INSTR_ETAPE("infoarena_hamilton");
+    INSTR_ETAPA("citire");
+    CititorRapid f("hamilton.in");
+    ScriitorRapid g("hamilton.out");
 
     int n, m;
     f >> n >> m;
-    vector<vector<pair<int, int>>> matriceAdiacentaCosturi(n); // matrice de adiacenta care retine si costul unei muchii
+    Graf graf(n, true);
     int a, b, c;
     for (int i = 0; i < m; i++) {
         f >> a >> b >> c;
-        matriceAdiacentaCosturi[a].push_back(make_pair(b, c));
+        graf.adaugareMuchie(a + 1, b + 1, c); // nodurile din fisier sunt numerotate de la 0
     }
-    Graf graf(n, false);
-    int sol = graf.hamilton(matriceAdiacentaCosturi);
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("algoritm");
+    int sol = graf.hamilton();
+    INSTR_ETAPA("afisare");
     g << sol;
 }
 
 void infoarena_amici2() {
-    ifstream f("amici2.in");
-    ofstream g("amici2.out");
+    INSTR_ETAPE("infoarena_amici2");
+    INSTR_ETAPA("citire");
+    CititorRapid f("amici2.in");
+    ScriitorRapid g("amici2.out");
 
     int nr_teste;
     f >> nr_teste;
+    // listele de adiacenta sunt refolosite de la un test la altul (golirea pastreaza memoria alocata),
+    // iar BFS_amici2 lucreaza in spatiul de lucru al firului, deci un test nu mai aloca nimic de ordinul lui n
+    vector<vector<int>> matriceAdiacenta;
+    Graf graf;
     for (int i = 0; i < nr_teste; i++) {
+        // etapele se repeta la fiecare test; timpii se aduna pe nume
+        INSTR_ETAPA("citire");
         int n, m;
         f >> n >> m;
-        Graf graf(n, false);
-        vector<vector<int>> matriceAdiacenta(n + 1);
+        // BFS_amici2 foloseste din graf doar numarul de noduri, deci ajunge un graf cel putin la fel de mare
+        if (graf.numarNoduri() < n) {
+            graf = Graf(n, false);
+            matriceAdiacenta.resize(n + 1);
+        }
+        for (int j = 0; j <= n; j++) {
+            matriceAdiacenta[j].clear();
+        }
         for (int j = 0; j < m; j++) {
             int x, y;
             f >> x >> y;
             matriceAdiacenta[x].push_back(y);
             matriceAdiacenta[y].push_back(x);
         }
-        g << graf.BFS_amici2(1, matriceAdiacenta) << '\n';
+        INSTR_ETAPA("algoritm");
+        int rezultat = graf.BFS_amici2(1, matriceAdiacenta);
+        INSTR_ETAPA("afisare");
+        g << rezultat << '\n';
     }
 }
 
 void infoarena_marmelada() {
-    ifstream f("marmelada.in");
-    ofstream g("marmelada.out");
+    INSTR_ETAPE("infoarena_marmelada");
+    INSTR_ETAPA("citire");
+    CititorRapid f("marmelada.in");
+    ScriitorRapid g("marmelada.out");
 
     int n, m, s, d;
     f >> n >> m >> s >> d;
     Graf graf(n, false);
-    vector<vector<pair<int, int>>> matriceAdiacenta(n+1);
-    for (int i = 1; i <= m; i++) {
-        int x, y;
-        f >> x >> y;
-        matriceAdiacenta[x].push_back(make_pair(y, i));
-        matriceAdiacenta[y].push_back(make_pair(x, i));
-    }
+    graf.citireGraf(f, m); // muchia i din fisier primeste id-ul i - 1
+    INSTR_ETAPA("constructie");
+    graf.inghetare();
+    INSTR_ETAPA("citire");
 
     vector<pair<int, int>> l(m + 1, {0,0});
     for (int i = 1; i <= m; i++) {
@@ -1214,9 +4817,10 @@ void infoarena_marmelada() {
         l[i] = make_pair(x, i);
     }
 
+    INSTR_ETAPA("algoritm");
     vector<int> vizitate(n + 1, 0), muchii(m + n + 1);
 
-    graf.bfs_marmelada(s, matriceAdiacenta, vizitate, muchii);
+    graf.bfs_marmelada(s, vizitate, muchii);
 
     sort(l.begin(), l.end());
     vector<int> result(m+1, 0);
@@ -1224,7 +4828,7 @@ void infoarena_marmelada() {
     int dd = d;
     int ct = 1;
     while (vizitate[dd] > 0) {
-        result[muchii[dd]] = l[ct].second;
+        result[muchii[dd] + 1] = l[ct].second;
         dd = vizitate[dd];
         ct++;
     }
@@ -1236,30 +4840,809 @@ void infoarena_marmelada() {
         }
     }
 
+    INSTR_ETAPA("afisare");
     for (int i = 1; i <= m; i++) {
         g << result[i] << '\n';
     }
 }
 
+/*
+ * Masoara viteza de parsare a numerelor dintr-un fisier cu CititorRapid si cu ifstream
+ * Afiseaza numarul de numere citite, timpul si throughput-ul (MB/s) pentru fiecare variante
+ */
+void benchmark_citire(const char *numeFisier) {
+    auto start = chrono::steady_clock::now();
+    CititorRapid f(numeFisier);
+    if (!f.esteDeschis()) {
+        cout << "Fisierul " << numeFisier << " nu poate fi deschis\n";
+        return;
+    }
+    long long suma = 0, numere = 0, x;
+    while (f.maiExistaNumere()) {
+        f >> x;
+        suma += x;
+        numere++;
+    }
+    size_t octeti = f.octetiCititi();
+    double secunde = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "CititorRapid: " << numere << " numere, " << secunde << " s, "
+         << octeti / (1024.0 * 1024.0) / secunde << " MB/s (suma " << suma << ")\n";
+
+    start = chrono::steady_clock::now();
+    ifstream g(numeFisier);
+    long long sumaStream = 0, numereStream = 0;
+    while (g >> x) {
+        sumaStream += x;
+        numereStream++;
+    }
+    secunde = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "ifstream:     " << numereStream << " numere, " << secunde << " s, "
+         << octeti / (1024.0 * 1024.0) / secunde << " MB/s (suma " << sumaStream << ")\n";
+}
+
+/*
+ * Compara construirea unui graf cu nrMuchii muchii aleatoare prin adaugareMuchie (urmata de inghetare)
+ * cu constructorul care primeste lista de muchii, pe un fir si pe toate nucleele
+ */
+void benchmark_constructie(const int nrNoduri, const long long nrMuchii) {
+    vector<pair<int, int>> muchii(nrMuchii);
+    unsigned long long stare = 88172645463325252ULL;
+    for (long long i = 0; i < nrMuchii; i++) {
+        xorshift(stare);
+        muchii[i].first = (int) (stare % nrNoduri) + 1;
+        muchii[i].second = (int) ((stare >> 32) % nrNoduri) + 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    {
+        Graf graf(nrNoduri, false);
+        for (auto &it: muchii) {
+            graf.adaugareMuchie(it.first, it.second);
+        }
+        graf.inghetare();
+    }
+    double secunde = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "adaugareMuchie + inghetare: " << secunde << " s\n";
+
+    int nrFire[] = {1, nrFireImplicit()};
+    for (int fire: nrFire) {
+        start = chrono::steady_clock::now();
+        Graf graf(nrNoduri, muchii, false, {}, fire);
+        secunde = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "constructie din lista de muchii (" << fire << " fire): " << secunde << " s\n";
+    }
+}
+
+/*
+ * Generatoare de grafuri sintetice pentru benchmark-uri; nodurile sunt numerotate de la 1
+ * generareAleator: nrMuchii muchii cu capete uniform aleatoare (fara bucle)
+ * generareGrila: grila linii x coloane, fiecare celula legata de vecina din dreapta si de cea de jos
+ * generareRMAT: graf cu distributie power-law a gradelor (R-MAT cu a = 0.57, b = c = 0.19), 2^scara noduri
+ * generareDrum: drumul 1 - 2 - ... - nrNoduri
+ * generareDAGComplet: arcele i -> j pentru toti i < j
+ */
+vector<pair<int, int>> generareAleator(const int nrNoduri, const long long nrMuchii, unsigned long long stare) {
+    vector<pair<int, int>> muchii;
+    if (nrNoduri < 2) {
+        return muchii;
+    }
+    muchii.reserve(nrMuchii);
+    while ((long long) muchii.size() < nrMuchii) {
+        unsigned long long r = xorshift(stare);
+        int x = (int) (r % nrNoduri) + 1, y = (int) ((r >> 32) % nrNoduri) + 1;
+        if (x != y) {
+            muchii.emplace_back(x, y);
+        }
+    }
+    return muchii;
+}
+
+vector<pair<int, int>> generareGrila(const int linii, const int coloane) {
+    vector<pair<int, int>> muchii;
+    muchii.reserve(2LL * linii * coloane);
+    for (int i = 0; i < linii; i++) {
+        for (int j = 0; j < coloane; j++) {
+            int nod = i * coloane + j + 1;
+            if (j + 1 < coloane) {
+                muchii.emplace_back(nod, nod + 1);
+            }
+            if (i + 1 < linii) {
+                muchii.emplace_back(nod, nod + coloane);
+            }
+        }
+    }
+    return muchii;
+}
+
+vector<pair<int, int>> generareRMAT(const int scara, const long long nrMuchii, unsigned long long stare) {
+    vector<pair<int, int>> muchii;
+    muchii.reserve(nrMuchii);
+    while ((long long) muchii.size() < nrMuchii) {
+        int x = 0, y = 0;
+        for (int nivel = 0; nivel < scara; nivel++) {
+            int r = (int) (xorshift(stare) % 100);
+            x = x * 2 + (r >= 76); // quadrantul c (19%) sau d (5%)
+            y = y * 2 + ((r >= 57 && r < 76) || r >= 95); // quadrantul b (19%) sau d (5%)
+        }
+        if (x != y) {
+            muchii.emplace_back(x + 1, y + 1);
+        }
+    }
+    return muchii;
+}
+
+vector<pair<int, int>> generareDrum(const int nrNoduri) {
+    vector<pair<int, int>> muchii;
+    muchii.reserve(nrNoduri);
+    for (int i = 1; i < nrNoduri; i++) {
+        muchii.emplace_back(i, i + 1);
+    }
+    return muchii;
+}
+
+vector<pair<int, int>> generareDAGComplet(const int nrNoduri) {
+    vector<pair<int, int>> muchii;
+    muchii.reserve((long long) nrNoduri * (nrNoduri - 1) / 2);
+    for (int i = 1; i <= nrNoduri; i++) {
+        for (int j = i + 1; j <= nrNoduri; j++) {
+            muchii.emplace_back(i, j);
+        }
+    }
+    return muchii;
+}
+
+vector<int> generareCosturi(const long long nrMuchii, const int costMaxim, unsigned long long stare) {
+    vector<int> costuri(nrMuchii);
+    for (long long i = 0; i < nrMuchii; i++) {
+        costuri[i] = (int) (xorshift(stare) % costMaxim) + 1;
+    }
+    return costuri;
+}
+
+/*
+ * Ruleaza functia de repetari ori si scrie o linie JSON cu timpul minim si mediu
+ * Valoarea intoarsa de functie (de exemplu o suma a distantelor) este afisata ca "control",
+ * astfel incat un rezultat gresit sa fie observat la fel de usor ca o regresie de timp
+ * nrFire = numarul de fire de executie folosite de algoritm (pentru masuratorile de scalabilitate)
+ */
+void masurareAlgoritm(const string &generator, int nrNoduri, long long nrMuchii, const string &algoritm,
+                      const string &reprezentare, int repetari, const function<long long()> &functie,
+                      int nrFire = 1) {
+    double minim = numeric_limits<double>::max(), total = 0;
+    long long control = 0;
+    for (int i = 0; i < repetari; i++) {
+        auto start = chrono::steady_clock::now();
+        control = functie();
+        double secunde = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        minim = min(minim, secunde);
+        total += secunde;
+    }
+    cout << "{\"generator\": \"" << generator << "\", \"noduri\": " << nrNoduri << ", \"muchii\": " << nrMuchii
+         << ", \"algoritm\": \"" << algoritm << "\", \"reprezentare\": \"" << reprezentare
+         << "\", \"fire\": " << nrFire << ", \"repetari\": " << repetari << ", \"secunde_min\": " << minim
+         << ", \"secunde_medie\": " << total / repetari << ", \"control\": " << control << "}" << endl;
+}
+
+long long sumaDistante(const vector<int> &distanta) {
+    long long suma = 0;
+    for (size_t i = 1; i < distanta.size(); i++) {
+        if (distanta[i] != INT_MAX && distanta[i] > 0) {
+            suma += distanta[i];
+        }
+    }
+    return suma;
+}
+
+/*
+ * Masoara algoritmii pe un graf neorientat cu costuri, atat in forma CSR (inghetat) cat si cu matricea de adiacenta
+ * Euler ruleaza pe acelasi graf cu fiecare muchie dublata, ca toate gradele sa fie pare
+ * excentricitati este masurata doar pana la 20000 de noduri
+ */
+void benchmarkNeorientat(const string &generator, int nrNoduri, const vector<pair<int, int>> &muchii,
+                         int repetari) {
+    long long m = muchii.size();
+    vector<int> costuri = generareCosturi(m, 100, 1234567);
+    Graf csr(nrNoduri, muchii, false, costuri);
+    Graf matrice(csr);
+    matrice.dezghetare();
+
+    // puntile mentinute la fiecare muchie adaugata, fara nicio parcurgere (nu depinde de reprezentare)
+    masurareAlgoritm(generator, nrNoduri, m, "PuntiIncrementale", "incremental", repetari, [&]() {
+        PuntiIncrementale punti(nrNoduri);
+        for (auto &muchie: muchii) {
+            punti.adaugareMuchie(muchie.first, muchie.second);
+        }
+        return (long long) punti.numarPunti();
+    });
+
+    for (Graf *graf: {&csr, &matrice}) {
+        string reprezentare = graf->inghetat() ? "csr" : "matrice";
+        masurareAlgoritm(generator, nrNoduri, m, "distantaMinimaBFS", reprezentare, repetari, [&]() {
+            return sumaDistante(graf->distantaMinimaBFS(1));
+        });
+        masurareAlgoritm(generator, nrNoduri, m, "distantaMinimaBFSHibrid", reprezentare, repetari, [&]() {
+            return sumaDistante(graf->distantaMinimaBFSHibrid(1));
+        });
+        // 100 de interogari intre perechi aleatoare de noduri (aceleasi la fiecare rulare)
+        masurareAlgoritm(generator, nrNoduri, m, "drumMinimBFS", reprezentare, repetari, [&]() {
+            unsigned long long stare = 31337;
+            long long suma = 0;
+            for (int i = 0; i < 100; i++) {
+                int start = (int) (xorshift(stare) % nrNoduri) + 1, final = (int) (xorshift(stare) % nrNoduri) + 1;
+                suma += (long long) graf->drumMinimBFS(start, final).size() - 1;
+            }
+            return suma;
+        });
+        // scalabilitatea BFS-ului paralel: 1, 2, 4, ... fire, pana la numarul de nuclee
+        for (int fire = 1;; fire = min(2 * fire, nrFireImplicit())) {
+            masurareAlgoritm(generator, nrNoduri, m, "distantaMinimaBFSParalel", reprezentare, repetari, [&]() {
+                return sumaDistante(graf->distantaMinimaBFSParalel(1, fire));
+            }, fire);
+            if (fire == nrFireImplicit()) {
+                break;
+            }
+        }
+        masurareAlgoritm(generator, nrNoduri, m, "componenteConexe", reprezentare, repetari, [&]() {
+            return (long long) graf->componenteConexe();
+        });
+        for (int fire = 1;; fire = min(2 * fire, nrFireImplicit())) {
+            masurareAlgoritm(generator, nrNoduri, m, "componenteConexeParalel", reprezentare, repetari, [&]() {
+                vector<int> componenta;
+                return (long long) graf->componenteConexeParalel(componenta, fire);
+            }, fire);
+            if (fire == nrFireImplicit()) {
+                break;
+            }
+        }
+        masurareAlgoritm(generator, nrNoduri, m, "DFS_muchiiCritice", reprezentare, repetari, [&]() {
+            return (long long) graf->DFS_muchiiCritice().size();
+        });
+        masurareAlgoritm(generator, nrNoduri, m, "puntiSiArticulatii", reprezentare, repetari, [&]() {
+            vector<int> punti, articulatii;
+            graf->puntiSiArticulatii(punti, articulatii);
+            return (long long) punti.size() + (long long) articulatii.size();
+        });
+        masurareAlgoritm(generator, nrNoduri, m, "componenteBiconexe", reprezentare, repetari, [&]() {
+            vector<int> blocMuchie, articulatii;
+            return (long long) graf->componenteBiconexe(blocMuchie, articulatii).numarNoduri();
+        });
+        // O(n (n + m) D / 64), deci doar pe grafurile mici
+        if (nrNoduri <= 20000) {
+            masurareAlgoritm(generator, nrNoduri, m, "excentricitati", reprezentare, repetari, [&]() {
+                vector<int> excentricitate = graf->excentricitati();
+                return (long long) *max_element(excentricitate.begin(), excentricitate.end());
+            });
+        }
+        masurareAlgoritm(generator, nrNoduri, m, "dijkstra", reprezentare, repetari, [&]() {
+            return sumaDistante(graf->dijkstra(1));
+        });
+        masurareAlgoritm(generator, nrNoduri, m, "bellman_ford", reprezentare, repetari, [&]() {
+            return sumaDistante(graf->bellman_ford(1));
+        });
+    }
+
+    vector<vector<int>> muchiiAPM(m);
+    for (long long i = 0; i < m; i++) {
+        muchiiAPM[i] = {muchii[i].first, muchii[i].second, costuri[i]};
+    }
+    masurareAlgoritm(generator, nrNoduri, m, "APM", "lista", repetari, [&]() {
+        return (long long) csr.APM(muchiiAPM).back()[0];
+    });
+
+    vector<pair<int, int>> muchiiDublate(muchii);
+    muchiiDublate.insert(muchiiDublate.end(), muchii.begin(), muchii.end());
+    Graf eulerian(nrNoduri, muchiiDublate, false);
+    masurareAlgoritm(generator, nrNoduri, 2 * m, "Euler", "csr", repetari, [&]() {
+        return (long long) eulerian.Euler().size();
+    });
+}
+
+/*
+ * Suita de benchmark-uri: genereaza grafuri sintetice la nrScari scari (~10^3, 10^4, 10^5 noduri)
+ * si masoara fiecare algoritm al clasei Graf, plus Roy-Floyd pe matrici dense
+ * Rezultatele sunt afisate cate o linie JSON pe masuratoare (JSON Lines), ca sa poata fi comparate intre commit-uri
+ */
+void benchmark_algoritmi(int nrScari, int repetari) {
+    const int laturi[] = {32, 100, 316}; // latura grilei; restul grafurilor au acelasi numar de noduri
+    nrScari = min(nrScari, 3);
+    for (int scara = 0; scara < nrScari; scara++) {
+        int latura = laturi[scara];
+        int n = latura * latura;
+
+        benchmarkNeorientat("aleator", n, generareAleator(n, 4LL * n, 88172645463325252ULL + scara), repetari);
+        benchmarkNeorientat("grila", n, generareGrila(latura, latura), repetari);
+        int scaraRMAT = 0;
+        while ((1 << (scaraRMAT + 1)) <= n) {
+            scaraRMAT++;
+        }
+        benchmarkNeorientat("rmat", 1 << scaraRMAT, generareRMAT(scaraRMAT, 8LL << scaraRMAT, 2463534242ULL + scara),
+                            repetari);
+        benchmarkNeorientat("drum", n, generareDrum(n), repetari);
+
+        // grila implicita (fara muchii memorate) cu 25% ziduri, cu prima linie si prima coloana libere,
+        // de 16 ori mai multe celule decat grila explicita
+        int laturaImplicita = 4 * latura;
+        GrafGrila grilaImplicita(laturaImplicita, laturaImplicita);
+        unsigned long long stareZiduri = 42 + scara;
+        for (int i = 0; i < laturaImplicita; i++) {
+            for (int j = 0; j < laturaImplicita; j++) {
+                if (xorshift(stareZiduri) % 4 == 0 && i > 0 && j > 0) {
+                    grilaImplicita.setareCelula(i, j, GrafGrila::ZID);
+                }
+            }
+        }
+        int nrCelule = laturaImplicita * laturaImplicita;
+        masurareAlgoritm("grila_implicita", nrCelule, 2LL * nrCelule, "distanteBFS", "grila", repetari, [&]() {
+            return sumaDistante(grilaImplicita.distanteBFS(grilaImplicita.index(0, 0)));
+        });
+        masurareAlgoritm("grila_implicita", nrCelule, 2LL * nrCelule, "etichetareComponente", "grila", repetari, [&]() {
+            vector<int> eticheta;
+            return (long long) grilaImplicita.etichetareComponente(eticheta);
+        });
+
+        // sortarea topologica pe un DAG complet cu 128, 512, 2048 noduri (pana la ~2 milioane de arce)
+        int nrNoduriDAG = 128 << (2 * scara);
+        vector<pair<int, int>> arce = generareDAGComplet(nrNoduriDAG);
+        Graf dag(nrNoduriDAG, arce, true);
+        masurareAlgoritm("dag_complet", nrNoduriDAG, arce.size(), "DFS_sortareTopologica", "csr", repetari, [&]() {
+            return (long long) dag.DFS_sortareTopologica().front();
+        });
+        for (int fire = 1;; fire = min(2 * fire, nrFireImplicit())) {
+            masurareAlgoritm("dag_complet", nrNoduriDAG, arce.size(), "sortareTopologicaParalel", "csr", repetari, [&]() {
+                vector<int> ordine, nivel, ciclu;
+                return (long long) dag.sortareTopologicaParalel(ordine, nivel, ciclu, fire);
+            }, fire);
+            if (fire == nrFireImplicit()) {
+                break;
+            }
+        }
+
+        // componentele tare conexe pe un graf orientat aleator (o componenta gigant si multe noduri izolate de trim)
+        vector<pair<int, int>> arceOrientate = generareAleator(n, 2LL * n, 5783321ULL + scara);
+        Graf orientat(n, arceOrientate, true);
+        masurareAlgoritm("aleator_orientat", n, arceOrientate.size(), "componenteTareConexe", "csr", repetari, [&]() {
+            vector<int> componenta;
+            return (long long) orientat.componenteTareConexe(componenta).numarNoduri();
+        });
+        for (int fire = 1;; fire = min(2 * fire, nrFireImplicit())) {
+            masurareAlgoritm("aleator_orientat", n, arceOrientate.size(), "componenteTareConexeParalel", "csr",
+                             repetari, [&]() {
+                        vector<int> componenta;
+                        return (long long) orientat.componenteTareConexeParalel(componenta, fire).numarNoduri();
+                    }, fire);
+            if (fire == nrFireImplicit()) {
+                break;
+            }
+        }
+
+        // acelasi graf cu arcele orientate de la nodul mai mic la cel mai mare: un DAG cu niveluri late
+        vector<pair<int, int>> arceDAG(arceOrientate);
+        for (auto &arc: arceDAG) {
+            arc = {min(arc.first, arc.second), max(arc.first, arc.second)};
+        }
+        Graf dagAleator(n, arceDAG, true);
+        masurareAlgoritm("dag_aleator", n, arceDAG.size(), "DFS_sortareTopologica", "csr", repetari, [&]() {
+            return (long long) dagAleator.DFS_sortareTopologica().front();
+        });
+        for (int fire = 1;; fire = min(2 * fire, nrFireImplicit())) {
+            masurareAlgoritm("dag_aleator", n, arceDAG.size(), "sortareTopologicaParalel", "csr", repetari, [&]() {
+                vector<int> ordine, nivel, ciclu;
+                return (long long) dagAleator.sortareTopologicaParalel(ordine, nivel, ciclu, fire);
+            }, fire);
+            if (fire == nrFireImplicit()) {
+                break;
+            }
+        }
+        // arcele aleatoare adaugate pe rand in ordinea topologica incrementala (cele care ar inchide un ciclu sunt
+        // refuzate); in ordine aleatoare regiunile afectate cresc odata cu graful, deci doar pe grafurile mici
+        if (n <= 20000) {
+            masurareAlgoritm("aleator_orientat", n, arceOrientate.size(), "OrdineTopologicaIncrementala",
+                             "incremental", repetari, [&]() {
+                        OrdineTopologicaIncrementala ordine(n);
+                        long long acceptate = 0;
+                        for (auto &arc: arceOrientate) {
+                            acceptate += ordine.adaugareArc(arc.first, arc.second);
+                        }
+                        return acceptate;
+                    });
+        }
+
+        // algoritmii exponentiali / cubici au nevoie de dimensiuni proprii
+        int nrNoduriHamilton = 10 + 2 * scara;
+        vector<pair<int, int>> arceHamilton = generareAleator(nrNoduriHamilton, nrNoduriHamilton * nrNoduriHamilton / 2,
+                                                              1181783497276652981ULL);
+        Graf grafHamilton(nrNoduriHamilton, arceHamilton, true, generareCosturi(arceHamilton.size(), 100, 7));
+        masurareAlgoritm("aleator", nrNoduriHamilton, arceHamilton.size(), "hamilton", "csr", repetari, [&]() {
+            return (long long) grafHamilton.hamilton();
+        });
+
+        int nrNoduriFloyd = 100 << scara;
+        vector<int> costuriFloyd = generareCosturi((long long) nrNoduriFloyd * nrNoduriFloyd, 1000, 99);
+        for (int i = 0; i < nrNoduriFloyd; i++) {
+            costuriFloyd[i * nrNoduriFloyd + i] = 0;
+        }
+        masurareAlgoritm("matrice_densa", nrNoduriFloyd, (long long) nrNoduriFloyd * (nrNoduriFloyd - 1), "royFloyd",
+                         "matrice", repetari, [&]() {
+                    vector<int> matrice(costuriFloyd);
+                    royFloyd(nrNoduriFloyd, matrice);
+                    long long suma = 0;
+                    for (int cost: matrice) {
+                        suma += cost;
+                    }
+                    return suma;
+                });
+    }
+}
+
 /* -------------------------------------------------------------- */
 
-int main() {
-//    infoarena_bfs();
-//    infoarena_dfs();
-//    leetcode_CriticalConnections();
-//    leetcode_CriticalConnections_neeficient();
-//    infoarena_sortareTopologica();
-//    infoarena_disjoint();
-//    infoarena_dijkstra();
-//    infoarena_bellman_ford();
-//    infoarena_muzeu();
-//    infoarena_darb();
-//    infoarena_royfloyd();
-//    havel_hakimi({0, 1, 2, 3});
-//    infoarena_ciclu_eulerian();
-//    infoarena_apm();
-//    infoarena_hamilton();
-//    infoarena_amici2();
-    infoarena_marmelada();
+/*
+ * Afiseaza un vector de distante (indexat de la 1), cu -1 pentru nodurile neatinse
+ */
+void afisareDistante(ScriitorRapid &out, const vector<int> &distanta) {
+    for (size_t i = 1; i < distanta.size(); i++) {
+        out << (distanta[i] == INT_MAX ? -1 : distanta[i]) << ' ';
+    }
+    out << '\n';
+}
+
+/*
+ * Interpretor de comenzi: graful este incarcat o singura data si apoi sunt executate pe el toate comenzile citite
+ * Fiecare comanda afiseaza rezultatul pe o linie in out, iar durata ei este afisata in cerr
+ * Comenzi:
+ *   incarca <fisier> <orientat 0/1> <costuri 0/1>  - fisier text: n m, urmat de m muchii "x y" sau "x y c"
+ *   incarcabinar <fisier>                         - fisier salvat cu salveaza
+ *   salveaza <fisier>
+ *   adauga <x> <y> [c]    sterge <x> <y>
+ *   bfs <s>    bfshibrid <s>    bfsparalel <s>    dijkstra <s>    bellman <s>
+ *     (pe un graf fara costuri, dijkstra si bellman considera ca fiecare muchie are costul 1)
+ *   bfsmulti <k> <s1> ... <sk>  - distanta si sursa cea mai apropiata pentru fiecare nod (doua linii)
+ *   excentricitati    drum <s> <t>  - lungimea unui drum minim de la s la t (-1 daca nu exista), urmata de noduri
+ *   componente    componenteparalel  - numarul de componente, urmat de componenta fiecarui nod
+ *   punti    articulatii  - id-urile puntilor si nodurile de articulatie (doua linii, fiecare precedata de numarul lor)
+ *   nrpunti    estepunte <x> <y>  - puntile sunt mentinute incremental de la primul apel, inclusiv la adauga
+ *   ordinetopo    pozitietopo <x>  - ordinea topologica mentinuta incremental de la primul apel (vezi
+ *                                   urmarireOrdineTopologica); de atunci adauga afiseaza "ciclu" pentru arcele refuzate
+ *   biconexe  - numarul de blocuri si de articulatii, blocul fiecarei muchii (dupa id), apoi articulatiile
+ *   ctc    ctcparalel  - numarul de componente tare conexe, urmat de componenta fiecarui nod; ambele numeroteaza
+ *                        componentele in ordine topologica, dar nu neaparat in aceeasi (indicii pot diferi)
+ *   topo  - ordinea topologica (Kahn); pentru un graf cu ciclu -1, urmat de lungimea si nodurile unui ciclu
+ *   topoparalel  - numarul de niveluri, ordinea topologica si nivelul fiecarui nod; pentru un graf cu ciclu
+ *                  -1, urmat de lungimea si nodurile unui ciclu
+ *   apm    euler
+ *   iesire
+ */
+void ruleaza_comenzi(istream &in, ScriitorRapid &out) {
+    Graf graf(0, false);
+    string comanda;
+    int nrComenzi = 0;
+    double timpTotal = 0;
+
+    // raspunsul fiecarei comenzi este scris imediat (inclusiv dupa continue), ca sa apara inaintea urmatoarei citiri
+    for (; in >> comanda && comanda != "iesire"; out.scriere()) {
+        auto start = chrono::steady_clock::now();
+        auto nodValid = [&](int nod) {
+            if (nod < 1 || nod > graf.numarNoduri()) {
+                out << "nod invalid: " << nod << '\n';
+                return false;
+            }
+            return true;
+        };
+
+        if (comanda == "incarca") {
+            string numeFisier;
+            int orientat, costuri;
+            in >> numeFisier >> orientat >> costuri;
+            CititorRapid f(numeFisier.c_str());
+            if (!f.esteDeschis()) {
+                out << "fisierul nu poate fi deschis: " << numeFisier.c_str() << '\n';
+                continue;
+            }
+            int n, m;
+            f >> n >> m;
+            if (!f.esteValid() || n < 0 || m < 0) {
+                out << "fisier invalid: " << numeFisier.c_str() << '\n';
+                continue;
+            }
+            graf = Graf(n, orientat != 0);
+            if (costuri) {
+                graf.citireGrafCosturi(f, m);
+            } else {
+                graf.citireGraf(f, m);
+            }
+            graf.inghetare();
+            if (!f.esteValid()) {
+                out << "fisier trunchiat: " << numeFisier.c_str() << ", " << graf.numarMuchii() << " muchii citite\n";
+                continue;
+            }
+            out << n << ' ' << m << '\n';
+        } else if (comanda == "incarcabinar") {
+            string numeFisier;
+            in >> numeFisier;
+            if (graf.incarcareBinar(numeFisier.c_str())) {
+                out << graf.numarNoduri() << ' ' << graf.numarMuchii() << '\n';
+            } else {
+                out << "fisier binar invalid: " << numeFisier.c_str() << '\n';
+            }
+        } else if (comanda == "salveaza") {
+            string numeFisier;
+            in >> numeFisier;
+            out << (graf.salvareBinar(numeFisier.c_str()) ? "OK" : "EROARE") << '\n';
+        } else if (comanda == "adauga" || comanda == "sterge") {
+            // restul liniei poate contine si costul
+            string linie;
+            getline(in, linie);
+            istringstream argumente(linie);
+            int x = 0, y = 0, c;
+            argumente >> x >> y;
+            if (!nodValid(x) || !nodValid(y)) {
+                continue;
+            }
+            int id = 0;
+            if (comanda == "sterge") {
+                graf.eliminareMuchie(x, y);
+            } else if (argumente >> c) {
+                id = graf.adaugareMuchie(x, y, c);
+            } else {
+                id = graf.adaugareMuchie(x, y);
+            }
+            out << (id == -1 ? "ciclu\n" : "OK\n");
+        } else if (comanda == "bfs" || comanda == "bfshibrid" || comanda == "bfsparalel" || comanda == "dijkstra" ||
+                   comanda == "bellman") {
+            int s;
+            in >> s;
+            if (!nodValid(s)) {
+                continue;
+            }
+            graf.inghetare();
+            if (comanda == "bfs") {
+                afisareDistante(out, graf.distantaMinimaBFS(s));
+            } else if (comanda == "bfshibrid") {
+                afisareDistante(out, graf.distantaMinimaBFSHibrid(s));
+            } else if (comanda == "bfsparalel") {
+                afisareDistante(out, graf.distantaMinimaBFSParalel(s));
+            } else if (comanda == "dijkstra") {
+                afisareDistante(out, graf.dijkstra(s));
+            } else {
+                vector<int> dist = graf.bellman_ford(s);
+                if (dist.empty()) {
+                    out << "Ciclu negativ!\n";
+                } else {
+                    afisareDistante(out, dist);
+                }
+            }
+        } else if (comanda == "bfsmulti") {
+            int k;
+            in >> k;
+            vector<int> surse(max(k, 0));
+            bool valid = true;
+            for (int &sursa: surse) {
+                in >> sursa;
+                valid = valid && nodValid(sursa);
+            }
+            if (!valid) {
+                continue;
+            }
+            graf.inghetare();
+            vector<int> sursaApropiata;
+            vector<int> distanta = graf.distantaMinimaBFSMultiSursa(surse, sursaApropiata);
+            afisareDistante(out, distanta);
+            afisareDistante(out, sursaApropiata);
+        } else if (comanda == "drum") {
+            int s, t;
+            in >> s >> t;
+            if (!nodValid(s) || !nodValid(t)) {
+                continue;
+            }
+            graf.inghetare();
+            vector<int> drum = graf.drumMinimBFS(s, t);
+            out << (int) drum.size() - 1;
+            for (int nod: drum) {
+                out << ' ' << nod;
+            }
+            out << '\n';
+        } else if (comanda == "excentricitati") {
+            graf.inghetare();
+            afisareDistante(out, graf.excentricitati());
+        } else if (comanda == "componente") {
+            graf.inghetare();
+            out << graf.componenteConexe() << '\n';
+        } else if (comanda == "componenteparalel") {
+            graf.inghetare();
+            vector<int> componenta;
+            out << graf.componenteConexeParalel(componenta) << '\n';
+            afisareDistante(out, componenta);
+        } else if (comanda == "punti") {
+            graf.inghetare();
+            vector<vector<int>> punti = graf.DFS_muchiiCritice();
+            out << (int) punti.size();
+            for (auto &it: punti) {
+                out << ' ' << it[0] << ' ' << it[1];
+            }
+            out << '\n';
+        } else if (comanda == "articulatii") {
+            graf.inghetare();
+            vector<int> punti, articulatii;
+            graf.puntiSiArticulatii(punti, articulatii);
+            for (vector<int> *lista: {&punti, &articulatii}) {
+                out << (int) lista->size();
+                for (int it: *lista) {
+                    out << ' ' << it;
+                }
+                out << '\n';
+            }
+        } else if (comanda == "nrpunti") {
+            out << graf.numarPunti() << '\n';
+        } else if (comanda == "estepunte") {
+            int x, y;
+            in >> x >> y;
+            if (!nodValid(x) || !nodValid(y)) {
+                continue;
+            }
+            out << (graf.estePunte(x, y) ? 1 : 0) << '\n';
+        } else if (comanda == "ordinetopo") {
+            const vector<int> &ordine = graf.ordineTopologicaCurenta();
+            out << (int) ordine.size();
+            for (int nod: ordine) {
+                out << ' ' << nod;
+            }
+            out << '\n';
+        } else if (comanda == "pozitietopo") {
+            int x;
+            in >> x;
+            if (!nodValid(x)) {
+                continue;
+            }
+            out << graf.pozitieTopologica(x) << '\n';
+        } else if (comanda == "biconexe") {
+            graf.inghetare();
+            vector<int> blocMuchie, articulatii;
+            Graf arbore = graf.componenteBiconexe(blocMuchie, articulatii);
+            out << arbore.numarNoduri() - (int) articulatii.size() << ' ' << (int) articulatii.size() << '\n';
+            for (int bloc: blocMuchie) {
+                out << bloc << ' ';
+            }
+            out << '\n';
+            for (int nod: articulatii) {
+                out << nod << ' ';
+            }
+            out << '\n';
+        } else if (comanda == "ctc" || comanda == "ctcparalel") {
+            graf.inghetare();
+            vector<int> componenta;
+            Graf condensare = comanda == "ctc" ? graf.componenteTareConexe(componenta)
+                                               : graf.componenteTareConexeParalel(componenta);
+            out << condensare.numarNoduri() << '\n';
+            afisareDistante(out, componenta);
+        } else if (comanda == "topo" || comanda == "topoparalel") {
+            graf.inghetare();
+            vector<int> ordine, nivel, ciclu;
+            int nrNiveluri = graf.sortareTopologicaParalel(ordine, nivel, ciclu);
+            if (comanda == "topoparalel" || nrNiveluri == -1) {
+                out << nrNiveluri << '\n';
+            }
+            if (nrNiveluri == -1) {
+                out << (int) ciclu.size();
+                for (int nod: ciclu) {
+                    out << ' ' << nod;
+                }
+                out << '\n';
+            } else {
+                for (int nod: ordine) {
+                    out << nod << ' ';
+                }
+                out << '\n';
+                if (comanda == "topoparalel") {
+                    afisareDistante(out, nivel);
+                }
+            }
+        } else if (comanda == "apm") {
+            vector<vector<int>> sol = graf.APM(graf.muchiiCuCosturi());
+            out << sol.back()[0] << ' ' << (int) sol.size() - 1;
+            for (size_t i = 0; i + 1 < sol.size(); i++) {
+                out << ' ' << sol[i][0] << ' ' << sol[i][1];
+            }
+            out << '\n';
+        } else if (comanda == "euler") {
+            graf.inghetare();
+            vector<int> sol = graf.Euler();
+            for (int nod: sol) {
+                out << nod << ' ';
+            }
+            out << '\n';
+        } else {
+            string linie;
+            getline(in, linie);
+            out << "comanda necunoscuta: " << comanda.c_str() << '\n';
+            continue;
+        }
+
+        double microsecunde = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        timpTotal += microsecunde;
+        nrComenzi++;
+        cerr << comanda << ": " << microsecunde << " us\n";
+    }
+
+    if (nrComenzi > 0) {
+        cerr << nrComenzi << " comenzi, " << timpTotal << " us in total, " << timpTotal / nrComenzi
+             << " us in medie\n";
+    }
+}
+
+/*
+ * Fara argumente ruleaza problema implicita (pentru evaluatoarele care nu dau argumente)
+ * <problema>            - ruleaza una dintre problemele de mai jos
+ * comenzi [fisier]      - interpretorul de comenzi, cu comenzile citite din fisier sau de la tastatura
+ * benchcitire <fisier>  - benchmark_citire
+ * benchconstructie <n> <m> - benchmark_constructie
+ */
+int main(int argc, char **argv) {
+    map<string, function<void()>> probleme = {
+            {"bfs",                 infoarena_bfs},
+            {"dfs",                 infoarena_dfs},
+            {"criticalconnections", leetcode_CriticalConnections},
+            {"sortaret",            infoarena_sortareTopologica},
+            {"disjoint",            infoarena_disjoint},
+            {"dijkstra",            infoarena_dijkstra},
+            {"bellmanford",         infoarena_bellman_ford},
+            {"muzeu",               infoarena_muzeu},
+            {"darb",                infoarena_darb},
+            {"royfloyd",            infoarena_royfloyd},
+            {"ciclueuler",          infoarena_ciclu_eulerian},
+            {"apm",                 infoarena_apm},
+            {"hamilton",            infoarena_hamilton},
+            {"amici2",              infoarena_amici2},
+            {"marmelada",           infoarena_marmelada},
+    };
+
+    // --binar: problemele de mai jos scriu rezultatele in modul binar al lui ScriitorRapid (comenzi scrie tot text)
+    if (argc >= 2 && strcmp(argv[1], "--binar") == 0) {
+        ScriitorRapid::iesireBinara = true;
+        argc--, argv++;
+    }
+
+    if (argc < 2) {
+        infoarena_marmelada();
+        return 0;
+    }
+
+    string argument = argv[1];
+    if (argument == "comenzi") {
+        ScriitorRapid out(stdout);
+        if (argc >= 3) {
+            ifstream script(argv[2]);
+            if (!script) {
+                cerr << "Fisierul " << argv[2] << " nu poate fi deschis\n";
+                return 1;
+            }
+            ruleaza_comenzi(script, out);
+        } else {
+            ruleaza_comenzi(cin, out);
+        }
+        return 0;
+    }
+
+    if (argument == "benchcitire" && argc >= 3) {
+        benchmark_citire(argv[2]);
+        return 0;
+    }
+    if (argument == "benchconstructie" && argc >= 4) {
+        benchmark_constructie(atoi(argv[2]), atoll(argv[3]));
+        return 0;
+    }
+    if (argument == "bench") {
+        benchmark_algoritmi(argc >= 3 ? atoi(argv[2]) : 2, argc >= 4 ? atoi(argv[3]) : 3);
+        return 0;
+    }
+
+    if (probleme.find(argument) == probleme.end()) {
+        cerr << "Problema necunoscuta: " << argument << "\nProbleme:";
+        for (auto &it: probleme) {
+            cerr << ' ' << it.first;
+        }
+        cerr << " comenzi benchcitire benchconstructie bench\nOptiune: --binar <problema> (rezultate in format binar)\n";
+        return 1;
+    }
+    probleme[argument]();
     return 0;
 }
\ No newline at end of file